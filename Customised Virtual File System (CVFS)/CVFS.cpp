@@ -15,6 +15,31 @@
 //                 - File permissions handling
 //                 - In-memory inode based architecture
 //                 - Command based user interface
+//                 - Parallel SIMD content search (grep)
+//                 - Per block CRC32C checksums with background scrubbing
+//                 - Hard links and rename over shared inodes
+//                 - 64 bit file sizes with huge page backed block pool
+//                 - On disk image with 2Q page cache of bounded memory
+//                 - Sequential readahead and write behind coalescing
+//                 - Sparse files with holes and data/hole seeking
+//                 - Truncate and append mode
+//                 - FIFO files over lock free ring buffers
+//                 - Memory quotas of session and directory
+//                 - Lazily initialised inode table
+//                 - Hot and cold inode arrays, interned names
+//                 - Buddy allocator with online defragmentation
+//                 - Atomic batches of create, write and unlink
+//                 - Cold files spilled to backing file, faulted back
+//                 - Copy on write file copies sharing data blocks
+//                 - Mapped views of files with dirty block tracking
+//                 - Binary trace of calls with timed or fast replay
+//                 - Bulk create and unlink of numbered or matching names
+//                 - Paged listing sorted by name, size or inode
+//                 - Advisory whole file and byte range locks
+//                 - Background jobs of shell on thread pool
+//                 - Parallel ingest of host directory trees
+//                 - Incremental checkpoints of changed inodes and blocks
+//                 - Trace points of internals dumped as Chrome trace
 //
 //                 The system is designed to simulate how file systems
 //                 internally manage files using concepts such as
@@ -36,9 +61,26 @@
 
 #include<stdio.h>
 #include<stdlib.h>
+#include<stddef.h>
 #include<unistd.h>
 #include<stdbool.h>
 #include<string.h>
+#include<pthread.h>
+#include<time.h>
+#include<sys/mman.h>
+#include<fcntl.h>
+#include<sys/uio.h>
+#include<sched.h>
+#include<fnmatch.h>
+#include<dirent.h>
+#include<sys/stat.h>
+#include<errno.h>
+#include<limits.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+#define CVFS_X86
+#endif
 
 ///////////////////////////////////////////////////////////
 //
@@ -46,26 +88,271 @@
 //
 //////////////////////////////////////////////////////////
 
-// Maximum file size that we allow in the project
+// Maximum data accepted by one write command of shell
 #define MAXFILESIZE 50
 
 #define MAXOPENFILES 20
 
+#ifndef MAXINODE
 #define MAXINODE 5
+#endif
 
 #define READ 1
 #define WRITE 2
 #define EXECUTE 4
+#define APPEND 8
+#define NONBLOCK 16
 
 #define START 0
 #define CURRENT 1
 #define END 2
+#define NEXTDATA 3
+#define NEXTHOLE 4
 
 #define EXECUTE_SUCCESS 0
 
 #define REGULARFILE 1
 #define SPECIALFILE 2
 
+// Upper limit of worker threads used by content search
+#define MAXSEARCHTHREADS 8
+
+// Upper limit of threads which run background jobs of shell
+#define JOBTHREADS 8
+
+// Upper limit of threads which read host files while ingesting
+#define INGESTTHREADS 16
+
+// Host files read before they are put into CVFS under one lock
+#define INGESTBATCH 256
+
+// States of background job
+#define JOB_QUEUED 0
+#define JOB_RUNNING 1
+#define JOB_DONE 2
+
+// Returned by shell command which ends the shell
+#define SHELL_EXIT 1
+
+// Size of one block of file data which is protected by one checksum
+#define BLOCKSIZE 4096
+
+// Entry of block map for part of file which is never written
+#define HOLEBLOCK -1
+
+// Address space reserved for data blocks of all files
+#define POOLSIZE (16LL * 1024 * 1024 * 1024)
+
+// Large files get their blocks in chunks of one huge page
+#define HUGEPAGESIZE (2 * 1024 * 1024)
+#define CHUNKBLOCKS (HUGEPAGESIZE / BLOCKSIZE)
+
+// Free blocks of small region are buddies of 1 to CHUNKBLOCKS blocks
+#define BUDDYORDERS 10
+
+// Defragmenter wakes up after this many ms and moves up to DEFRAGBATCH files
+#define DEFRAGINTERVAL 1000
+#define DEFRAGBATCH 16
+
+// File of this size or more is treated as large file
+#define HUGEFILESIZE HUGEPAGESIZE
+
+// Backing of chunks of large files
+#define HUGEPAGE_OFF 0
+#define HUGEPAGE_TRANSPARENT 1
+#define HUGEPAGE_EXPLICIT 2
+
+// Blocks searched by one search thread at a time
+#define SEARCHBLOCKS 256
+
+// Times search brings back files which were spilled again meanwhile
+#define SEARCHRETRIES 3
+
+// Default number of blocks verified per second by scrub thread
+#define SCRUBRATE 64
+
+// Polynomial of CRC32C (Castagnoli) in reversed form
+#define CRC32CPOLY 0x82F63B78
+
+// Number of buckets of directory name index, one per inode for large
+// DILB so that bulk create and unlink do not walk long chains
+#define DIRHASHSIZE ((MAXINODE > 1024) ? MAXINODE : 1024)
+
+// Ring buffer of one FIFO file (power of 2)
+#define FIFOSIZE (64 * 1024)
+
+// Checks of FIFO before a blocked reader or writer sleeps
+#define FIFOSPINS 100
+
+// Default and upper limit of memory used by page cache of image
+#define CACHESIZE (64 * 1024 * 1024)
+#define MAXCACHESIZE (4LL * 1024 * 1024 * 1024)
+#define MAXCACHEFRAMES (MAXCACHESIZE / BLOCKSIZE)
+
+// Buckets of page cache index (power of 2)
+#define CACHEHASHBITS 20
+
+// Queues of 2Q replacement which a frame can be part of
+#define CACHE_FREE 0
+#define CACHE_A1IN 1
+#define CACHE_AM 2
+
+// Dirty frames are written back by flusher after this many ms
+#define FLUSHINTERVAL 1000
+
+// Flags of GetBlock
+#define CACHE_READ 0
+#define CACHE_NEW 1
+
+// Blocks moved by one read or write call on image
+#define MAXIOVECS 64
+
+// Inodes initialised at a time, rest of DILB is only reserved
+#define INODEBATCH 64
+
+// Longest file name
+#define MAXNAMELENGTH 255
+
+// Shell line holds command, two longest names or patterns and small arguments
+#define MAXCOMMANDLINE (2 * (MAXNAMELENGTH + 8) + 128)
+
+// Names are cut from chunks of this size in steps of NAMEALIGN
+#define NAMECHUNK (64 * 1024)
+#define NAMEALIGN 8
+#define NAMECLASSES ((sizeof(NAME) + MAXNAMELENGTH) / NAMEALIGN + 1)
+
+// Readahead window of sequential reader grows from MIN to MAX blocks
+#define MINREADAHEAD 4
+#define MAXREADAHEAD 64
+
+// Per CPU counters of one quota (power of 2)
+#define QUOTASLOTS 64
+
+// Usage a counter may hold before it is folded into quota
+#define QUOTABYTEBATCH (16 * BLOCKSIZE)
+#define QUOTAINODEBATCH 4
+
+// Tier thread ticks after this many ms, idle time of file is in ticks
+#define TIERINTERVAL 1000
+
+// Files spilled by tier thread in one tick at most
+#define TIERBATCH 64
+
+// Backing file of spilled files, created in current directory
+#define TIERFILE "CVFS.tier.XXXXXX"
+
+// Operations which can be staged in a transaction
+#define TRANSACTION_CREATE 1
+#define TRANSACTION_WRITE 2
+#define TRANSACTION_UNLINK 3
+
+// Calls which are recorded in trace
+#define TRACE_CREATE 1
+#define TRACE_OPEN 2
+#define TRACE_CLOSE 3
+#define TRACE_READ 4
+#define TRACE_WRITE 5
+#define TRACE_LSEEK 6
+#define TRACE_UNLINK 7
+#define TRACE_TRUNCATE 8
+#define TRACE_LINK 9
+#define TRACE_RENAME 10
+#define TRACE_COPY 11
+#define TRACE_MKFIFO 12
+#define TRACE_CREATEMANY 13
+#define TRACE_UNLINKMANY 14
+#define TRACE_UNLINKMATCH 15
+#define TRACE_INGEST 16
+#define TRACE_BATCHCREATE 17
+#define TRACE_BATCHWRITE 18
+#define TRACE_BATCHUNLINK 19
+#define TRACE_COMMIT 20
+#define TRACE_MMAP 21
+#define TRACE_MSTORE 22
+#define TRACE_MSYNC 23
+#define TRACE_MUNMAP 24
+#define TRACEOPS 25
+
+// Records collected in memory before they are written to trace file
+#define TRACEBUFFER (64 * 1024)
+
+// First bytes of trace file
+#define TRACEMAGIC "CVFSTRC1"
+#define TRACEMAGICSIZE 8
+
+// Levels of skip lists which keep files in listing order
+#define INDEXLEVELS 24
+
+// Orders of directory listing
+#define LIST_NAME 0
+#define LIST_SIZE 1
+#define LIST_INODE 2
+
+// Entries listed under one hold of lock
+#define LISTPAGE 512
+
+// Output collected before it is printed
+#define LISTBUFFER (64 * 1024)
+
+// Modes of advisory locks
+#define LOCK_RELEASE 0
+#define LOCK_SHARED 1
+#define LOCK_EXCLUSIVE 2
+
+// Timeout of lock which waits till it is granted
+#define LOCK_FOREVER -1
+
+// Decades of wait time from 10 us to 10 s and above
+#define LOCKBUCKETS 8
+
+// First bytes of checkpoint file
+#define CKPTMAGIC "CVFSCKP1"
+#define CKPTMAGICSIZE 8
+
+// Marks of start and end of one checkpoint in checkpoint file
+#define CKPT_BEGIN 0x54504B43
+#define CKPT_END 0x454E4F44
+
+// Kinds of records of checkpoint
+#define CKPT_INODE 1
+#define CKPT_BLOCK 2
+
+// Dirty blocks copied under one hold of lock
+#define CKPTBATCH 256
+
+// Records collected in memory before they are written
+#define CKPTBUFFER (1024 * 1024)
+
+// Trace points of internals, build with -DCVFS_NO_EVENTS to remove them
+#define EV_CREATEFILE 0
+#define EV_OPENFILE 1
+#define EV_CLOSEFILE 2
+#define EV_READFILE 3
+#define EV_WRITEFILE 4
+#define EV_UNLINKFILE 5
+#define EV_TRUNCATEFILE 6
+#define EV_LOOKUP 7
+#define EV_ALLOCINODE 8
+#define EV_FILLHOLES 9
+#define EV_COPYIN 10
+#define EV_COPYOUT 11
+#define EV_CHECKSUM 12
+#define EV_LOCKWAIT 13
+#define EVENTTYPES 14
+
+// Events kept by ring of each thread, power of two
+#define EVENTSLOTS 65536
+
+// Output collected before it is written to dump file
+#define EVENTBUFFER (64 * 1024)
+
+// Event from here to end of enclosing block, recorded only while events are on
+#ifndef CVFS_NO_EVENTS
+#define EVENT_SCOPE(id,arg) EVENTSPAN EventSpan __attribute__((cleanup(EndEvent))) = BeginEvent(id,arg)
+#else
+#define EVENT_SCOPE(id,arg)
+#endif
+
 //////////////////////////////////////////////////////////
 //
 //  User Defined Macros for error handling
@@ -86,6 +373,20 @@
 
 #define ERR_MAX_FILES_OPEN -8
 
+#define ERR_CHECKSUM_MISMATCH -9
+
+#define ERR_WOULD_BLOCK -10
+#define ERR_BROKEN_PIPE -11
+
+#define ERR_QUOTA_EXCEEDED -12
+
+#define ERR_TRANSACTION -13
+
+#define ERR_TIMED_OUT -14
+#define ERR_DEADLOCK -15
+
+#define ERR_IO -16
+
 //////////////////////////////////////////////////////////
 //
 //  User Defined Structures
@@ -116,28 +417,114 @@ struct SuperBlock
 {
     int TotalInodes;
     int FreeInodes;
+    int ReadyInodes;                // Initialised part of DILB
+    int ScrubRate;                  // Blocks per second, 0 means paused
+    int ScrubPasses;                // Completed walks over all blocks
+    long long ScrubbedBlocks;
+    long long ChecksumErrors;       // Found by read as well as scrub
+    int LastBadInode;
+    long long LastBadBlock;
+    long long WriteCalls;
+    long long WriteCommits;         // Writes which reached blocks
+    long long ReadCalls;
+    long long MapSyncs;             // Syncs of mapped views
+    long long MapDirtyBlocks;       // Blocks written back by them
+};
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    Fifo
+//  Description :       Holds the ring buffer of FIFO file. Head is
+//                      moved only by writer and Tail only by reader,
+//                      each on its own cache line.
+//
+//////////////////////////////////////////////////////////
+
+struct Fifo
+{
+    char *Data;
+    long long Capacity;
+    volatile long long Head __attribute__((aligned(64)));     // Bytes ever written
+    volatile long long Tail __attribute__((aligned(64)));     // Bytes ever read
+    int Readers __attribute__((aligned(64)));   // Open tables with READ
+    int Writers;                                // Open tables with WRITE
+    volatile int Waiting;                       // Threads sleeping on Wakeup
+    pthread_mutex_t WriteLock;                  // Writers take turns, free for single one
+    pthread_mutex_t ReadLock;                   // Readers take turns, free for single one
+    pthread_mutex_t WaitLock;
+    pthread_cond_t Wakeup;
+};
+
+typedef struct Fifo FIFO;
+typedef struct Fifo * PFIFO;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    QuotaSlot
+//  Description :       Holds usage charged to quota by threads
+//                      running on one CPU since last fold
+//
+//////////////////////////////////////////////////////////
+
+struct QuotaSlot
+{
+    long long Bytes __attribute__((aligned(64)));
+    long long Inodes;
+};
+
+typedef struct QuotaSlot QUOTASLOT;
+typedef struct QuotaSlot * PQUOTASLOT;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    Quota
+//  Description :       Holds limits and usage of memory of one
+//                      session or one directory. Charges go to
+//                      counter of current CPU and are folded into
+//                      Bytes and Inodes when counter grows past
+//                      batch or when usage gets near the limit.
+//
+//////////////////////////////////////////////////////////
+
+struct Quota
+{
+    const char *Name;
+    long long ByteLimit;            // 0 means no limit
+    long long InodeLimit;           // 0 means no limit
+    long long Bytes;                // Usage folded from slots
+    long long Inodes;
+    long long Refused;              // Charges over the limit
+    pthread_mutex_t Lock;           // Serialises folding
+    QUOTASLOT Slots[QUOTASLOTS];
 };
 
+typedef struct Quota QUOTA;
+typedef struct Quota * PQUOTA;
+
 //////////////////////////////////////////////////////////
 //
 //  Structure Name :    Inode
-//  Description :       Holds the information about file
+//  Description :       Holds the information about file which is
+//                      used by almost every operation. Inodes
+//                      are kept in one array, so scans over them
+//                      touch only these fields.
 //
 //////////////////////////////////////////////////////////
 
-#pragma pack(1)
+#pragma pack(push,1)
 struct Inode
 {
-    char FileName[20];
+    long long FileSize;         // Bytes covered by block map, holes too
+    long long ActualFileSize;
+    long long Blocks;           // Allocated blocks, holes excluded
+    long long *BlockMap;        // Pool block of each block of file
     int InodeNumber;
-    int FileSize;
-    int ActualFileSize;
     int FileType;
-    int ReferenceCount;
+    int LinkCount;              // Directory entries of this inode
+    int ReferenceCount;         // Directory entries + open file tables
     int Permission;
-    char *Buffer;
-    struct Inode *next;
 };
+#pragma pack(pop)
 
 typedef struct Inode INODE;
 typedef struct Inode * PINODE;
@@ -145,582 +532,15308 @@ typedef struct Inode ** PPINODE;
 
 //////////////////////////////////////////////////////////
 //
-//  Structure Name :    FileTable
-//  Description :       Holds the information about opened file
+//  Structure Name :    InodeCold
+//  Description :       Holds the information about file which is
+//                      needed only while its blocks are allocated
+//                      or freed. Entry has same index as inode.
 //
 //////////////////////////////////////////////////////////
 
-struct FileTable
+struct InodeCold
 {
-    int ReadOffset;
-    int WriteOffset;
-    int Mode;
-    PINODE ptrinode;
+    long long BlockMapSize;     // Capacity of BlockMap
+    long long HugeNext;         // Next unused block of chunk owned by file
+    int HugeLeft;               // Unused blocks of that chunk
+    PFIFO Fifo;                 // Ring buffer of SPECIALFILE
+    PQUOTA Owner;               // Quota of session which created it
+    long long Changes;          // Bumped whenever data or blocks change
+    unsigned int LastAccess;    // Tick of tier clock of last read or write
+    bool Spilled;               // Data lives in backing file
+    long long TierStart;        // First block of data in backing file
+    struct DirEntry *Entries;   // All names of inode
+    struct IndexNode *SizeNode; // Place in size index
+    bool SizeStale;             // Size changed since size index was refreshed
+    struct Inode *NextStale;    // Next inode with stale size
+    struct LockState *Locking;  // Advisory locks, NULL till first lock
+    bool CheckpointDirty;       // On dirty list of checkpoint
+    bool CheckpointAll;         // Every block goes to next checkpoint
+    struct Inode *NextDirty;    // Next inode changed since last checkpoint
+    unsigned char *DirtyBlocks; // Bitmap of blocks written since last checkpoint
+    long long DirtyBytes;       // Capacity of bitmap
+    long long MinSize;          // Smallest size since last checkpoint
 };
 
-typedef FileTable FILETABLE;
-typedef FileTable * PFILETABLE;
+typedef struct InodeCold INODECOLD;
+typedef struct InodeCold * PINODECOLD;
 
 //////////////////////////////////////////////////////////
 //
-//  Structure Name :    UAREA
-//  Description :       Holds the information about process file
+//  Structure Name :    Name
+//  Description :       Holds one interned file name. Every name
+//                      is stored once in name arena and shared by
+//                      all directory entries which use it.
 //
 //////////////////////////////////////////////////////////
 
-struct UAREA
+struct Name
 {
-    char ProcessName[20];
-    PFILETABLE UFDT[MAXOPENFILES];
+    struct Name *next;          // Next name in same bucket or free list
+    unsigned int Hash;          // FNV-1a of Text
+    int References;             // Directory entries using the name
+    char Text[1];               // Extends to length of name
 };
 
+typedef struct Name NAME;
+typedef struct Name * PNAME;
+
 //////////////////////////////////////////////////////////
 //
-//  Global variables or objects used in the project
+//  Structure Name :    NameArena
+//  Description :       Holds the memory of all names. Names are
+//                      cut from large chunks and freed names are
+//                      kept in lists by size for reuse.
 //
 //////////////////////////////////////////////////////////
 
-BootBlock bootobj;
-SuperBlock superobj;
-UAREA uareaobj;
+struct NameArena
+{
+    char *Chunk;                // Chunk names are cut from
+    int ChunkUsed;
+    PNAME FreeNames[NAMECLASSES];
+    PNAME Hash[DIRHASHSIZE];    // Interned names
+    int Names;
+    long long Bytes;            // Held by names now
+    long long Chunks;
+};
 
-PINODE head = NULL;
+typedef struct NameArena NAMEARENA;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     InitialiseUAREA
-//  Description :       It is used to initialise UAREA members
-//  Author :            Shravani Kishor Darandale
-//  Date :              13/01/2026
+//  Structure Name :    IndexNode
+//  Description :       Holds one file in skip list which keeps
+//                      files in listing order
 //
 //////////////////////////////////////////////////////////
 
-void InitialiseUAREA()
+struct IndexNode
 {
-   strcpy(uareaobj.ProcessName,"Myexe");
-   
-   int i = 0;
+    long long Value;            // Size of file, 0 in name index
+    int Number;                 // Inode number
+    PNAME Name;                 // Name in name index, NULL in size index
+    void *Item;                 // Directory entry or inode
+    int Levels;
+    struct IndexNode *next[1];  // Extends to Levels
+};
 
-   for(i = 0; i < MAXOPENFILES; i++)
-   {
-        uareaobj.UFDT[i] = NULL;
-   }
-    printf("Marvellous CVFS : UAREA gets initialised succesfully\n");
-}
+typedef struct IndexNode INDEXNODE;
+typedef struct IndexNode * PINDEXNODE;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     InitialiseSuperBlock
-//  Description :       It is used to initialise Super block members
-//  Author :            Shravani Kishor Darandale
-//  Date :              13/01/2026
+//  Structure Name :    OrderIndex
+//  Description :       Holds skip list of files sorted by one key
 //
 //////////////////////////////////////////////////////////
 
-void InitialiseSuperBlock()
+struct OrderIndex
 {
-    superobj.TotalInodes = MAXINODE;
-    superobj.FreeInodes = MAXINODE;
+    PINDEXNODE Head;            // Has all INDEXLEVELS levels
+    int Levels;                 // Levels in use
+    long long Count;
+    struct Inode *Stale;        // Inodes to move in size index
+};
 
-    printf("Marvellous CVFS : Super block gets initialised succesfully\n");
-}
+typedef struct OrderIndex ORDERINDEX;
+typedef struct OrderIndex * PORDERINDEX;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     CreateDILB
-//  Description :       It is used to create Linkedlist of inodes
-//  Author :            Shravani Kishor Darandale
-//  Date :              13/01/2026
+//  Structure Name :    ListCursor
+//  Description :       Holds the position of paged directory listing.
+//                      Position is the key of last listed file, so
+//                      files may change between pages.
 //
 //////////////////////////////////////////////////////////
 
-void CreateDILB()
+struct ListCursor
 {
-    int i = 1;
-    PINODE newn = NULL;
-    PINODE temp = head;
+    int Order;                  // LIST_NAME, LIST_SIZE or LIST_INODE
+    bool Started;
+    bool Done;
+    long long Value;            // Key of last listed file
+    int Number;
+    char Name[MAXNAMELENGTH + 1];
+    char *Output;               // Lines not yet printed
+    int Length;
+    int Capacity;
+};
 
-    for(i = 1; i <= MAXINODE; i++)
-    {
-        newn = (PINODE)malloc(sizeof(INODE));
+typedef struct ListCursor LISTCURSOR;
+typedef struct ListCursor * PLISTCURSOR;
 
-        strcpy(newn->FileName,"\0");
-        newn->InodeNumber = i;
-        newn->FileSize = 0;
-        newn->ActualFileSize = 0;
-        newn->FileType = 0;
-        newn->ReferenceCount = 0;
-        newn->Permission = 0;
-        newn->Buffer = NULL;
-        newn->next = NULL;
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    DirEntry
+//  Description :       Holds the name of file and the inode it
+//                      refers to. Many entries may refer to
+//                      same inode.
+//
+//////////////////////////////////////////////////////////
 
-        if(temp == NULL)    // LL is empty
-        {
-            head = newn;
-            temp = head;
-        }
-        else                // LL contains atleast 1 node
-        {
-            temp->next = newn;
-            temp = temp->next;
-        }
-    }
+struct DirEntry
+{
+    PNAME FileName;
+    PINODE ptrinode;
+    struct DirEntry *next;      // Next entry in same hash bucket
+    struct DirEntry *nextname;  // Next name of same inode
+    PINDEXNODE NameNode;        // Place in name index
+};
 
-    printf("Marvellous CVFS : DILB created succesfully\n");
-}
+typedef struct DirEntry DIRENTRY;
+typedef struct DirEntry * PDIRENTRY;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     StartAuxillaryDataInitilisation
-//  Description :       It is used to call all such functions which are
-//                      used to initialise auxillary data
-//  Author :            Shravani Kishor Darandale
-//  Date :              13/01/2026
+//  Structure Name :    BlockPool
+//  Description :       Holds the blocks of data of all files.
+//                      Small files take single blocks from the
+//                      bottom of pool, managed by buddy system.
+//                      Large files take whole huge page chunks
+//                      from the top of pool so that their data
+//                      stays contiguous.
 //
 //////////////////////////////////////////////////////////
 
-void StartAuxillaryDataInitilisation()
+struct BlockPool
 {
-    strcpy(bootobj.Information,"Booting process of Marvellous CVFS is done");
-
-    printf("%s\n",bootobj.Information);
+    char *Base;                 // Aligned to HUGEPAGESIZE
+    long long TotalBlocks;
+    long long UsedBlocks;
+    long long SmallNext;        // End of small region, grows by chunks
+    long long *BuddyNext;       // Links of free buddies of same order
+    long long *BuddyPrev;
+    char *BuddyOrder;           // Order + 1 of free buddy starting at block
+    long long FreeHead[BUDDYORDERS];
+    long long FreeCount[BUDDYORDERS];
+    long long FreeSmall;        // Free blocks of small region
+    int TotalChunks;
+    int HugeTop;                // Lowest chunk of huge region
+    int *FreeChunks;            // Stack of freed huge chunks
+    int FreeChunkCount;
+    int *ChunkUsed;             // Allocated blocks + reservation of owner
+    char *ChunkType;            // HUGEPAGE_xxx used to map the chunk
+    int HugeChunks;             // Chunks backed by huge pages now
+    int HugePageMode;           // Backing of newly allocated chunks
+    unsigned int *Checksum;     // CRC32C of each block
+    unsigned int ZeroChecksum;  // CRC32C of a block full of zeros
+    unsigned int *Shares;       // Other files sharing each block, 0 if private
+    long long SharedBlocks;     // Sum of Shares
+    long long Copies;           // Files copied by sharing blocks
+    long long CopiedOnWrite;    // Shared blocks made private by writes
+    bool DefragEnabled;         // Background defragmenter is running
+    long long DefragFiles;      // Files made contiguous
+    long long DefragBlocks;     // Blocks moved for them
+    long long DefragRetries;    // Moves lost to concurrent writes
+};
 
-    InitialiseSuperBlock();
+typedef struct BlockPool BLOCKPOOL;
 
-    CreateDILB();
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    TierExtent
+//  Description :       Holds one run of free blocks of backing file
+//
+//////////////////////////////////////////////////////////
 
-    InitialiseUAREA();
+struct TierExtent
+{
+    long long Start;
+    long long Count;
+};
 
-    printf("Marvellous CVFS : Auxillary data initialised succesfully\n");
-}
+typedef struct TierExtent TIEREXTENT;
+typedef struct TierExtent * PTIEREXTENT;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     DisplayHelp
-//  Description :       It is used to display the help page
-//  Author :            Shravani Kishor Darandale
-//  Date :              14/01/2026
+//  Structure Name :    TierStore
+//  Description :       Holds the backing file to which cold files
+//                      are spilled, policy of spilling and counters
+//                      of migrations. Data blocks of spilled file
+//                      are consecutive in backing file.
 //
 //////////////////////////////////////////////////////////
 
-void DisplayHelp()
+struct TierStore
 {
-    printf("-----------------------------------------------\n");
-    printf("---------- Marvellous CVFS Help Page ----------\n");
-    printf("-----------------------------------------------\n");
+    int Fd;                     // -1 until tiering is first enabled
+    bool Enabled;
+    long long High;             // Spilling starts above these bytes in pool
+    long long Low;              // and stops at these bytes
+    unsigned int Idle;          // Ticks without access before file is cold
+    unsigned int Clock;         // Ticks of tier thread
+    long long End;              // Blocks of backing file in use or free
+    unsigned int *Checksum;     // CRC32C of each block of backing file
+    long long Capacity;         // Entries of Checksum
+    PTIEREXTENT Free;           // Free runs sorted by start
+    int FreeCount;
+    int FreeCapacity;
+    long long SpilledFiles;
+    long long SpilledBlocks;
+    long long Spills;           // Files moved to backing file
+    long long Faults;           // Files moved back to memory
+    long long BlocksOut;
+    long long BlocksIn;
+    long long Retries;          // Spills lost to concurrent writes
+};
 
-    printf("man    : It is used to display manual page\n");
-    printf("clear  : It is used to clear the terminal\n");
-    printf("creat  : It is used to create new file\n");
-    printf("write  : It is used to write the data into file\n");
-    printf("read   : It is used to read the data from the file\n");
-    printf("stat   : It is used to display statistical information\n");
-    printf("unlink : It is used to delete the file\n");
-    printf("exit   : It is used to terminate Marvellous CVFS\n");
+typedef struct TierStore TIERSTORE;
 
-    printf("-----------------------------------------------\n");
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CacheFrame
+//  Description :       Holds the information about one frame of
+//                      page cache. Frames are linked by index in
+//                      one queue of 2Q and in one hash bucket.
+//
+//////////////////////////////////////////////////////////
 
-}
+struct CacheFrame
+{
+    long long Block;            // Image block held, -1 if free
+    int Queue;                  // CACHE_xxx
+    int Pins;                   // Users copying to or from frame now
+    bool Dirty;
+    int prev;
+    int next;
+    int hnext;                  // Next frame in same hash bucket
+};
+
+typedef struct CacheFrame CACHEFRAME;
+typedef struct CacheFrame * PCACHEFRAME;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     ManPageDisplay
-//  Description :       It is used to display man page
-//  Author :            Shravani Kishor Darandale
-//  Date :              14/01/2026
+//  Structure Name :    PageCache
+//  Description :       Holds the frames which cache blocks of on
+//                      disk image. Replacement is 2Q : blocks
+//                      seen once wait in A1in, blocks seen again
+//                      after leaving A1in (found in ghost queue
+//                      A1out) go to Am. One time scans therefore
+//                      never push hot blocks of Am out.
 //
 //////////////////////////////////////////////////////////
 
-void ManPageDisplay(char Name[])
+struct PageCache
 {
-    if(strcmp("ls",Name) == 0)
-    {
-        printf("About : It is used to list the names of all files\n");
-        printf("Usage : ls\n");
-    }
-    else if(strcmp("man",Name) == 0)
-    {
-        printf("About : It is used to display manual page\n");
-        printf("Usage : man command_name\n");
-        printf("command_name : It is the name of command\n");        
-    }
-    else if(strcmp("exit",Name) == 0)
-    {
-        printf("About : It is used to terminate the shell\n");
-        printf("Usage : exit\n");        
-    }
-    else if(strcmp("clear",Name) == 0)
-    {
-        printf("About : It is used to clear the shell\n");
-        printf("Usage : clear\n");        
-    }
-    else
-    {
-        printf("No manual entry for %s\n",Name);
-    }
-}
+    int ImageFd;                // -1 when data lives in block pool
+    const char *ImageName;
+    char *Frames;               // Data of all frames
+    PCACHEFRAME Info;
+    int *Hash;                  // First frame of each bucket
+    int *FreeFrames;            // Stack of frames given back
+    int FreeCount;
+    int NeverUsed;              // Frames above this are never touched
+    int Limit;                  // Frames allowed by memory budget
+    int InUse;
+    int A1inHead, A1inTail, A1inSize;
+    int AmHead, AmTail, AmSize;
+    long long *GhostBlock;      // Ring of blocks evicted from A1in
+    int *GhostNext;             // Next ghost in same hash bucket
+    int *GhostHash;
+    int GhostStart;
+    int GhostSize;
+    long long Hits;
+    long long Misses;
+    long long Evictions;
+    long long Writebacks;       // Blocks written to image
+    long long WriteOps;         // Calls which wrote them
+    long long ReadBlocks;       // Blocks read from image
+    long long ReadOps;          // Calls which read them
+    long long Prefetched;       // Blocks read ahead of reader
+};
+
+typedef struct PageCache PAGECACHE;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     IsFileExist
-//  Description :       It is used to check whether file is already exist or not
-//  Input :             It accepts file name
-//  Output :            It returns the true or false
-//  Author :            PShravani Kishor Darandale
-//  Date :              16/01/2026
+//  Structure Name :    FileTable
+//  Description :       Holds the information about opened file
 //
 //////////////////////////////////////////////////////////
 
-bool IsFileExist(
-                    char *name      // File name
-                )
+struct FileTable
 {
-    PINODE temp = head;
-    bool bFlag = false;
+    long long ReadOffset;
+    long long WriteOffset;
+    int Mode;
+    PINODE ptrinode;
+    long long LastReadEnd;      // Where previous read ended
+    int ReadAhead;              // Blocks of readahead window, 0 if random
+    long long ReadAheadEnd;     // Data up to here is prefetched
+    char *WriteBuffer;          // Small sequential writes of one block
+    long long BufferOffset;     // Offset of first buffered byte
+    int BufferLength;
+    long long FifoWriteTaken;   // Ring bytes held by GetFifoBuffer writer, -1 if none
+    long long FifoReadTaken;    // Ring bytes held by GetFifoBuffer reader, -1 if none
+    int References;             // Descriptor and FIFO calls running without lock
+    char *View;                 // Mapped view of file or NULL
+    long long ViewOffset;       // Offset of file where view starts
+    long long ViewLength;
+    char *ViewShadow;           // Copy of view as loaded
+    pthread_mutex_t OffsetLock; // Read offset and readahead, taken after file system lock
+};
 
-    while(temp != NULL)
-    {
-        if((strcmp(name,temp->FileName) == 0) && (temp->FileType == REGULARFILE))
-        {
-            bFlag = true;
-            break;
-        }
-        temp = temp->next;
-    }
-    
-    return bFlag;
-}
+typedef FileTable FILETABLE;
+typedef FileTable * PFILETABLE;
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     CreateFile
-//  Description :       It is used to create new regular file
-//  Input :             It accepts file name and permissions
-//  Output :            It returns the file descriptor
-//  Author :            Shravani Kishor Darandale
-//  Date :              16/01/2026
+//  Structure Name :    TransactionOp
+//  Description :       Holds one staged operation of transaction
+//                      and what is needed to undo it
 //
 //////////////////////////////////////////////////////////
 
-int CreateFile(
-                    char *name,         // Name of new file
-                    int permission      // Permission for that file
-                )
+struct TransactionOp
 {
-    PINODE temp = head;
-    int i = 0;
+    int Type;
+    char *Name;
+    int Permission;             // Of created file
+    char *Data;                 // Appended to file by write
+    long long Size;
+    PINODE ptrinode;            // Inode touched while applying
+    PDIRENTRY entry;            // Entry detached by unlink
+    long long OldSize;          // Size of file before write
+};
+
+typedef struct TransactionOp TRANSACTIONOP;
+typedef struct TransactionOp * PTRANSACTIONOP;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    Transaction
+//  Description :       Holds operations staged between begin and
+//                      commit, they are applied in order as a unit
+//
+//////////////////////////////////////////////////////////
+
+struct Transaction
+{
+    PTRANSACTIONOP Ops;
+    int Count;
+    int Capacity;
+};
+
+typedef struct Transaction TRANSACTION;
+typedef struct Transaction * PTRANSACTION;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    TraceRecord
+//  Description :       Holds one recorded call as it is stored in
+//                      trace file. Names used by call follow it,
+//                      second name after a zero byte.
+//
+//////////////////////////////////////////////////////////
+
+struct TraceRecord
+{
+    long long Time;             // Nano seconds since recording started
+    long long Offset;           // Of file for read, write and lseek
+    long long Size;             // Bytes, new size, mode or permission
+    int Fd;                     // Descriptor used or returned, permission of bulk create
+    unsigned short Op;
+    unsigned short NameLength;
+};
+
+typedef struct TraceRecord TRACERECORD;
+typedef struct TraceRecord * PTRACERECORD;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    TraceLog
+//  Description :       Holds the state of trace recorder
+//
+//////////////////////////////////////////////////////////
+
+struct TraceLog
+{
+    int Fd;                     // Trace file, -1 when not recording
+    char *Buffer;               // Records not yet written to file
+    int Length;
+    long long Start;            // Time when recording started
+    long long Records;
+    pthread_mutex_t Lock;       // Calls of all threads are recorded
+};
+
+typedef struct TraceLog TRACELOG;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    ReplayStat
+//  Description :       Holds latencies of one kind of call seen
+//                      while replaying trace
+//
+//////////////////////////////////////////////////////////
+
+struct ReplayStat
+{
+    long long *Latency;
+    long long Count;
+    long long Capacity;
+    long long Errors;           // Calls which returned error
+    long long Bytes;            // Read or written
+};
+
+typedef struct ReplayStat REPLAYSTAT;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    FileLock
+//  Description :       Holds one advisory lock on bytes of file.
+//                      Owner is the descriptor which took it.
+//
+//////////////////////////////////////////////////////////
+
+struct FileLock
+{
+    long long Start;
+    long long End;              // First byte after lock, LLONG_MAX for end of file
+    int Type;                   // LOCK_SHARED or LOCK_EXCLUSIVE
+    int Owner;                  // File descriptor
+    struct FileLock *next;
+};
+
+typedef struct FileLock FILELOCK;
+typedef struct FileLock * PFILELOCK;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    LockState
+//  Description :       Holds advisory locks of one inode and how
+//                      much they were fought over
+//
+//////////////////////////////////////////////////////////
+
+struct LockState
+{
+    PFILELOCK Held;
+    long long Acquired;
+    long long Contended;        // Requests which found conflicting lock
+    long long Refused;          // Non blocking requests which failed
+    long long Timeouts;
+    long long Deadlocks;
+    long long WaitTime;         // Nanoseconds spent waiting
+    long long MaxWait;
+    long long Histogram[LOCKBUCKETS];
+};
+
+typedef struct LockState LOCKSTATE;
+typedef struct LockState * PLOCKSTATE;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    LockWait
+//  Description :       Holds the request of descriptor which sleeps
+//                      for a lock. Lives on stack of sleeper.
+//
+//////////////////////////////////////////////////////////
+
+struct LockWait
+{
+    PINODE ptrinode;
+    long long Start;
+    long long End;
+    int Type;
+    bool Cancelled;             // Descriptor was closed meanwhile
+};
+
+typedef struct LockWait LOCKWAIT;
+typedef struct LockWait * PLOCKWAIT;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    LockTable
+//  Description :       Holds the state shared by advisory locks of
+//                      all files. Mutex is taken after file system
+//                      lock and never held while file system lock
+//                      is awaited.
+//
+//////////////////////////////////////////////////////////
+
+struct LockTable
+{
+    pthread_mutex_t Mutex;
+    pthread_cond_t Released;    // Broadcast when any lock is dropped
+    PLOCKWAIT Waiters[MAXOPENFILES];
+    long long Acquired;
+    long long Contended;
+    long long Refused;
+    long long Timeouts;
+    long long Deadlocks;
+};
+
+typedef struct LockTable LOCKTABLE;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    Job
+//  Description :       Holds one shell command which runs in
+//                      background and its progress
+//
+//////////////////////////////////////////////////////////
+
+struct Job
+{
+    int Id;
+    char Command[MAXCOMMANDLINE];
+    int State;                  // JOB_QUEUED, JOB_RUNNING or JOB_DONE
+    long long Start;            // Time when it started running
+    long long End;
+    long long Done;             // Progress reported by long operation
+    long long Total;            // 0 when total is not known
+    struct Job *next;
+};
+
+typedef struct Job JOB;
+typedef struct Job * PJOB;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    JobQueue
+//  Description :       Holds background jobs not yet reported and
+//                      the pool of threads which run them
+//
+//////////////////////////////////////////////////////////
+
+struct JobQueue
+{
+    pthread_mutex_t Lock;
+    pthread_cond_t Ready;       // Job is queued
+    pthread_cond_t Finished;    // Job is done
+    PJOB Jobs;                  // In order of id
+    int NextId;
+    int Threads;                // Started so far
+    int Idle;                   // Sleeping for a job
+    long long Completed;
+};
+
+typedef struct JobQueue JOBQUEUE;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    IngestFile
+//  Description :       Holds one host file found by walk of host
+//                      directory tree
+//
+//////////////////////////////////////////////////////////
+
+struct IngestFile
+{
+    char *Path;                 // Path on host
+    int NameOffset;             // Name in CVFS is path below ingested directory
+    char *Data;                 // Read by worker, NULL till then
+    long long Size;
+};
+
+typedef struct IngestFile INGESTFILE;
+typedef struct IngestFile * PINGESTFILE;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    IngestJob
+//  Description :       Holds the state of ingest shared by its
+//                      worker threads
+//
+//////////////////////////////////////////////////////////
+
+struct IngestJob
+{
+    PINGESTFILE Files;
+    long long Count;
+    long long Capacity;
+    long long NextFile;         // First file not claimed by any worker
+    long long Ingested;
+    long long Bytes;
+    long long Skipped;          // Present already, bad name or unreadable
+    int Error;                  // First error which stopped ingest
+    PINODE NextFree;            // Walk over DILB goes on from here
+};
+
+typedef struct IngestJob INGESTJOB;
+typedef struct IngestJob * PINGESTJOB;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CheckpointMark
+//  Description :       Holds the start or the end of one checkpoint
+//                      as it is stored in checkpoint file. Records
+//                      of checkpoint lie between them.
+//
+//////////////////////////////////////////////////////////
+
+struct CheckpointMark
+{
+    unsigned int Magic;         // CKPT_BEGIN or CKPT_END
+    unsigned int Records;       // Records of checkpoint, 0 in start mark
+    long long Sequence;         // Checkpoints of file are numbered from 1
+    long long Time;             // Seconds since epoch
+};
+
+typedef struct CheckpointMark CHECKPOINTMARK;
+typedef struct CheckpointMark * PCHECKPOINTMARK;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CheckpointRecord
+//  Description :       Holds one changed inode or block as it is
+//                      stored in checkpoint file. Names of inode,
+//                      each ended by zero byte, or data of block
+//                      follow it.
+//
+//////////////////////////////////////////////////////////
+
+struct CheckpointRecord
+{
+    unsigned int Type;          // CKPT_INODE or CKPT_BLOCK
+    unsigned int Check;         // CRC32C of rest of record and what follows
+    unsigned int Length;        // Bytes after record
+    int InodeNumber;
+    int FileType;               // 0 when inode is free
+    int Permission;
+    long long Value;            // Size of file or index of block
+    long long MinSize;          // Smallest size since last checkpoint
+};
+
+typedef struct CheckpointRecord CHECKPOINTRECORD;
+typedef struct CheckpointRecord * PCHECKPOINTRECORD;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CheckpointItem
+//  Description :       Holds the blocks of one file which are to
+//                      be copied after its metadata is written.
+//                      Each block is pinned by one more share.
+//
+//////////////////////////////////////////////////////////
+
+struct CheckpointItem
+{
+    int InodeNumber;
+    long long *Blocks;          // Pinned pool block of each block to copy
+    long long *Index;           // Block of file of each of them
+    long long Count;
+};
+
+typedef struct CheckpointItem CHECKPOINTITEM;
+typedef struct CheckpointItem * PCHECKPOINTITEM;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CheckpointWriter
+//  Description :       Holds the state of one checkpoint which is
+//                      being written
+//
+//////////////////////////////////////////////////////////
+
+struct CheckpointWriter
+{
+    int Fd;
+    char *Buffer;               // Records not yet written to file
+    long long Length;
+    long long Capacity;
+    long long Records;
+    long long Blocks;
+    long long Written;          // Bytes written to file so far
+    long long Start;            // Time when checkpoint started
+    int Bandwidth;              // MB per second, 0 for no limit
+    bool Failed;
+};
+
+typedef struct CheckpointWriter CHECKPOINTWRITER;
+typedef struct CheckpointWriter * PCHECKPOINTWRITER;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    CheckpointLog
+//  Description :       Holds inodes changed since last checkpoint
+//                      and counters of all checkpoints. Dirty list
+//                      is guarded by file system lock.
+//
+//////////////////////////////////////////////////////////
+
+struct CheckpointLog
+{
+    pthread_mutex_t Lock;       // One checkpoint or restore at a time
+    PINODE Dirty;               // Inodes changed since last checkpoint
+    long long DirtyInodes;
+    char *Path;                 // File of last checkpoint, NULL before first
+    long long Sequence;         // Of last checkpoint in that file
+    bool Failed;                // Last write failed, next one writes all files
+    long long Checkpoints;
+    long long Full;             // Checkpoints which wrote every file
+    long long Inodes;           // Inode records of all checkpoints
+    long long Blocks;
+    long long Bytes;
+    long long LastInodes;
+    long long LastBlocks;
+    long long LastBytes;
+    long long LastTime;         // Nano seconds taken by last checkpoint
+};
+
+typedef struct CheckpointLog CHECKPOINTLOG;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    Event
+//  Description :       Holds one finished trace point in ring of
+//                      thread which passed it
+//
+//////////////////////////////////////////////////////////
+
+struct Event
+{
+    long long Start;            // Nano seconds of monotonic clock
+    long long Duration;
+    long long Arg;              // Bytes, mode or descriptor, 0 if none
+    int Id;                     // EV_ value
+};
+
+typedef struct Event EVENT;
+typedef struct Event * PEVENT;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    EventSpan
+//  Description :       Holds trace point which is not finished yet.
+//                      Lives on stack of function being traced.
+//
+//////////////////////////////////////////////////////////
+
+struct EventSpan
+{
+    long long Start;            // 0 when events were off
+    long long Arg;
+    int Id;
+};
+
+typedef struct EventSpan EVENTSPAN;
+typedef struct EventSpan * PEVENTSPAN;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    EventRing
+//  Description :       Holds latest events of one thread. Only its
+//                      thread writes it, so recording takes no lock.
+//
+//////////////////////////////////////////////////////////
+
+struct EventRing
+{
+    EVENT Events[EVENTSLOTS];
+    volatile long long Head;    // Events ever recorded
+    long long Cleared;          // Events before it are not dumped
+    int Thread;                 // Thread id shown in dump
+    bool Free;                  // Thread exited, next new thread takes it
+    struct EventRing *next;
+};
+
+typedef struct EventRing EVENTRING;
+typedef struct EventRing * PEVENTRING;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    EventLog
+//  Description :       Holds rings of all threads which recorded
+//                      trace points
+//
+//////////////////////////////////////////////////////////
+
+struct EventLog
+{
+    volatile bool Enabled;
+    long long Origin;           // Time shown as 0 in dump
+    PEVENTRING Rings;
+    int Threads;
+    pthread_mutex_t Lock;       // Protects list of rings
+    pthread_key_t Key;          // Gives ring back when its thread exits
+};
+
+typedef struct EventLog EVENTLOG;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    UAREA
+//  Description :       Holds the information about process file
+//
+//////////////////////////////////////////////////////////
+
+struct UAREA
+{
+    char ProcessName[20];
+    PFILETABLE UFDT[MAXOPENFILES];
+    PQUOTA Quota;               // Memory charged to this session
+    PTRANSACTION Transaction;   // Open batch or NULL
+};
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    SearchResult
+//  Description :       Holds the offsets at which pattern is
+//                      found inside one range of blocks of file
+//
+//////////////////////////////////////////////////////////
+
+struct SearchResult
+{
+    PINODE ptrinode;
+    long long FirstBlock;
+    long long LastBlock;        // Excluded from range
+    long long *Offsets;
+    int Count;
+    int Capacity;
+};
+
+typedef struct SearchResult SEARCHRESULT;
+typedef struct SearchResult * PSEARCHRESULT;
+
+//////////////////////////////////////////////////////////
+//
+//  Structure Name :    SearchJob
+//  Description :       Holds the work shared by all search threads
+//
+//////////////////////////////////////////////////////////
+
+struct SearchJob
+{
+    const char *Pattern;
+    int PatternLength;
+    PSEARCHRESULT Results;
+    int ItemCount;
+    int NextItem;       // Next range to be picked by any thread
+};
+
+typedef struct SearchJob SEARCHJOB;
+typedef struct SearchJob * PSEARCHJOB;
+
+//////////////////////////////////////////////////////////
+//
+//  Global variables or objects used in the project
+//
+//////////////////////////////////////////////////////////
+
+BootBlock bootobj;
+SuperBlock superobj;
+UAREA uareaobj;
+
+PINODE head = NULL;
+
+// Address space of all MAXINODE inodes, head is its first inode
+PINODE InodeTable = NULL;
+PINODECOLD InodeColdTable = NULL;
+
+NAMEARENA Names;
+
+// Name index of root directory
+PDIRENTRY DirectoryHash[DIRHASHSIZE];
+
+// Files in order of name and of size, for listing
+ORDERINDEX NameIndex;
+ORDERINDEX SizeIndex;
+unsigned int IndexSeed = 2463534242u;
+
+// Memory used by files of current session and of root directory
+QUOTA SessionQuota;
+QUOTA DirectoryQuota;
+
+// Protects inodes and file tables against scrub and search threads
+pthread_rwlock_t FileSystemLock = PTHREAD_RWLOCK_INITIALIZER;
+
+unsigned int CRC32CTable[256];
+bool CRC32CHardware = false;
+
+// Widest instruction set used by search, 2 -> AVX2, 1 -> SSE2, 0 -> Scalar
+int SearchLevel = 0;
+
+BLOCKPOOL Pool;
+
+pthread_t ScrubThreadId;
+
+PAGECACHE Cache;
+
+// Protects page cache against all threads which access blocks
+pthread_mutex_t CacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+pthread_t FlusherThreadId;
+
+pthread_t DefragThreadId;
+
+TIERSTORE Tier;
+
+pthread_t TierThreadId;
+
+TRACELOG Trace;
+
+LOCKTABLE Locks;
+
+JOBQUEUE Jobs;
+
+CHECKPOINTLOG Checkpoint;
+
+EVENTLOG Events;
+
+// Ring of current thread, NULL till its first event
+__thread PEVENTRING EventRing = NULL;
+
+// Names of trace points in order of EV_ values
+const char *EventNames[EVENTTYPES] = {"CreateFile","OpenFile","CloseFile","ReadFile","WriteFile","UnlinkFile",
+                                      "TruncateFile","LookupDirEntry","AllocateInode","FillHoles","CopyToFile",
+                                      "CopyFromFile","UpdateChecksum","LockWait"};
+
+// Job run by current thread, NULL in shell and other threads
+__thread PJOB CurrentJob = NULL;
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     NanoTime()
+//  Description :       It is used to read monotonic clock
+//  Input :             Nothing
+//  Output :            Time in nano seconds
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long NanoTime()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    return (ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseEventRing()
+//  Description :      It is used when thread which has ring exits.
+//                      Events of ring stay for dump till new
+//                      thread takes it.
+//  Input :            Ring of exiting thread
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseEventRing(
+                        void *arg   // Ring of exiting thread
+                      )
+{
+    PEVENTRING ring = (PEVENTRING)arg;
+
+    pthread_mutex_lock(&Events.Lock);
+    ring->Free = true;
+    pthread_mutex_unlock(&Events.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseEvents()
+//  Description :      It is used to initialise trace points. They
+//                      stay off till they are turned on.
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseEvents()
+{
+    Events.Enabled = false;
+    Events.Origin = NanoTime();
+    Events.Rings = NULL;
+    Events.Threads = 0;
+
+    pthread_mutex_init(&Events.Lock,NULL);
+    pthread_key_create(&Events.Key,ReleaseEventRing);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AttachEventRing()
+//  Description :      It is used to give current thread a ring on
+//                      its first event. Ring of exited thread is
+//                      taken again before new one is made.
+//  Input :            Nothing
+//  Output :           Ring of current thread
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PEVENTRING AttachEventRing()
+{
+    PEVENTRING ring = NULL;
+
+    pthread_mutex_lock(&Events.Lock);
+
+    for(ring = Events.Rings; (ring != NULL) && (ring->Free == false); ring = ring->next)
+    {
+    }
+
+    if(ring == NULL)
+    {
+        ring = (PEVENTRING)calloc(1,sizeof(EVENTRING));
+
+        Events.Threads++;
+        ring->Thread = Events.Threads;
+        ring->next = Events.Rings;
+        Events.Rings = ring;
+    }
+
+    ring->Free = false;
+
+    pthread_mutex_unlock(&Events.Lock);
+
+    pthread_setspecific(Events.Key,ring);
+    EventRing = ring;
+
+    return ring;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BeginEvent()
+//  Description :      It is used to start trace point. Clock is
+//                      read only while events are on.
+//  Input :            Kind of event and its argument
+//  Output :           Started span
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+EVENTSPAN BeginEvent(
+                        int id,         // EV_ value
+                        long long arg   // Bytes, mode or descriptor
+                    )
+{
+    EVENTSPAN span;
+
+    span.Id = id;
+    span.Arg = arg;
+    span.Start = (Events.Enabled == true) ? NanoTime() : 0;
+
+    return span;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     EndEvent()
+//  Description :      It is used to finish trace point when its
+//                      block is left and to keep it in ring of
+//                      current thread. Oldest event of ring is
+//                      overwritten.
+//  Input :            Span started by BeginEvent
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void EndEvent(
+                PEVENTSPAN span     // Started span
+             )
+{
+    PEVENTRING ring = EventRing;
+    PEVENT event = NULL;
+    long long lHead = 0;
+
+    if(span->Start == 0)
+    {
+        return;
+    }
+
+    if(ring == NULL)
+    {
+        ring = AttachEventRing();
+    }
+
+    lHead = ring->Head;
+    event = &ring->Events[lHead & (EVENTSLOTS - 1)];
+
+    event->Start = span->Start;
+    event->Duration = NanoTime() - span->Start;
+    event->Arg = span->Arg;
+    event->Id = span->Id;
+
+    __atomic_store_n(&ring->Head,lHead + 1,__ATOMIC_RELEASE);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LockFileSystem()
+//  Description :      It is used to take file system lock. Time
+//                      spent waiting for it is a trace point.
+//  Input :            Whether lock is taken for write
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void LockFileSystem(
+                        bool exclusive      // Write lock or read lock
+                    )
+{
+    EVENT_SCOPE(EV_LOCKWAIT,exclusive ? 1 : 0);
+
+    if(exclusive == true)
+    {
+        pthread_rwlock_wrlock(&FileSystemLock);
+    }
+    else
+    {
+        pthread_rwlock_rdlock(&FileSystemLock);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ClearEvents()
+//  Description :      It is used to forget events recorded so far
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ClearEvents()
+{
+    PEVENTRING ring = NULL;
+
+    pthread_mutex_lock(&Events.Lock);
+
+    for(ring = Events.Rings; ring != NULL; ring = ring->next)
+    {
+        ring->Cleared = __atomic_load_n(&ring->Head,__ATOMIC_ACQUIRE);
+    }
+
+    pthread_mutex_unlock(&Events.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WriteEvents()
+//  Description :      It is used to write collected dump output
+//                      to dump file
+//  Input :            Descriptor of file, output and its length
+//  Output :           EXECUTE_SUCCESS or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int WriteEvents(
+                    int fd,             // Dump file
+                    const char *data,   // Output
+                    int length          // Bytes of output
+                )
+{
+    int iDone = 0;
+    int iRet = 0;
+
+    while(iDone < length)
+    {
+        iRet = write(fd,data + iDone,length - iDone);
+
+        if(iRet <= 0)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        iDone = iDone + iRet;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DumpEvents()
+//  Description :      It is used to write events of all rings as
+//                      Chrome trace JSON, which chrome://tracing
+//                      and Perfetto open. Ring is copied first and
+//                      entries its thread overwrote meanwhile are
+//                      left out.
+//  Input :            Host file
+//  Output :           Events written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long DumpEvents(
+                        const char *path    // Dump file of host
+                    )
+{
+    PEVENTRING ring = NULL;
+    PEVENT Copy = NULL;
+    PEVENT event = NULL;
+    char *Buffer = NULL;
+    long long lFirst = 0;
+    long long lLast = 0;
+    long long lHead = 0;
+    long long lWritten = 0;
+    long long i = 0;
+    int iLength = 0;
+    int iRet = EXECUTE_SUCCESS;
+    int fd = 0;
+
+    if(path == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    fd = open(path,O_WRONLY | O_CREAT | O_TRUNC,0644);
+
+    if(fd == -1)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    Copy = (PEVENT)malloc(EVENTSLOTS * sizeof(EVENT));
+    Buffer = (char *)malloc(EVENTBUFFER);
+
+    iLength = sprintf(Buffer,"{\"traceEvents\":[\n");
+
+    pthread_mutex_lock(&Events.Lock);
+
+    for(ring = Events.Rings; (ring != NULL) && (iRet == EXECUTE_SUCCESS); ring = ring->next)
+    {
+        lLast = __atomic_load_n(&ring->Head,__ATOMIC_ACQUIRE);
+        lFirst = (lLast - EVENTSLOTS > ring->Cleared) ? lLast - EVENTSLOTS : ring->Cleared;
+
+        for(i = lFirst; i < lLast; i++)
+        {
+            Copy[i & (EVENTSLOTS - 1)] = ring->Events[i & (EVENTSLOTS - 1)];
+        }
+
+        // Slot of event being recorded now may hold half of it
+        lHead = __atomic_load_n(&ring->Head,__ATOMIC_ACQUIRE);
+
+        if(lFirst < lHead + 1 - EVENTSLOTS)
+        {
+            lFirst = lHead + 1 - EVENTSLOTS;
+        }
+
+        for(i = lFirst; (i < lLast) && (iRet == EXECUTE_SUCCESS); i++)
+        {
+            event = &Copy[i & (EVENTSLOTS - 1)];
+
+            if((event->Id < 0) || (event->Id >= EVENTTYPES))
+            {
+                continue;
+            }
+
+            iLength = iLength + sprintf(Buffer + iLength,
+                                        "%s{\"name\":\"%s\",\"cat\":\"cvfs\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                        "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"arg\":%lld}}",
+                                        (lWritten == 0) ? "" : ",\n",EventNames[event->Id],ring->Thread,
+                                        (event->Start - Events.Origin) / 1000.0,event->Duration / 1000.0,event->Arg);
+            lWritten++;
+
+            if(iLength > EVENTBUFFER - 512)
+            {
+                iRet = WriteEvents(fd,Buffer,iLength);
+                iLength = 0;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&Events.Lock);
+
+    iLength = iLength + sprintf(Buffer + iLength,"\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = WriteEvents(fd,Buffer,iLength);
+    }
+
+    close(fd);
+    free(Buffer);
+    free(Copy);
+
+    return (iRet == EXECUTE_SUCCESS) ? lWritten : iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayEvents()
+//  Description :      It is used to display state of trace points
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayEvents()
+{
+    PEVENTRING ring = NULL;
+    long long lRecorded = 0;
+    long long lLost = 0;
+
+    pthread_mutex_lock(&Events.Lock);
+
+    for(ring = Events.Rings; ring != NULL; ring = ring->next)
+    {
+        lRecorded = lRecorded + ring->Head - ring->Cleared;
+
+        if(ring->Head - ring->Cleared > EVENTSLOTS)
+        {
+            lLost = lLost + ring->Head - ring->Cleared - EVENTSLOTS;
+        }
+    }
+
+#ifdef CVFS_NO_EVENTS
+    printf("Trace points        : removed from this build\n");
+#else
+    printf("Trace points        : %s, %lld events by %d threads, %lld overwritten\n",
+           (Events.Enabled == true) ? "on" : "off",lRecorded,Events.Threads,lLost);
+#endif
+
+    pthread_mutex_unlock(&Events.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseUAREA
+//  Description :       It is used to initialise UAREA members
+//  Author :            Shravani Kishor Darandale
+//  Date :              13/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseUAREA()
+{
+   strcpy(uareaobj.ProcessName,"Myexe");
+   
+   int i = 0;
+
+   for(i = 0; i < MAXOPENFILES; i++)
+   {
+        uareaobj.UFDT[i] = NULL;
+   }
+
+   uareaobj.Quota = &SessionQuota;
+   uareaobj.Transaction = NULL;
+    printf("Marvellous CVFS : UAREA gets initialised succesfully\n");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseSuperBlock
+//  Description :       It is used to initialise Super block members
+//  Author :            Shravani Kishor Darandale
+//  Date :              13/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseSuperBlock()
+{
+    superobj.TotalInodes = MAXINODE;
+    superobj.FreeInodes = MAXINODE;
+    superobj.ScrubRate = SCRUBRATE;
+    superobj.ScrubPasses = 0;
+    superobj.ScrubbedBlocks = 0;
+    superobj.ChecksumErrors = 0;
+    superobj.LastBadInode = 0;
+    superobj.LastBadBlock = 0;
+    superobj.WriteCalls = 0;
+    superobj.WriteCommits = 0;
+    superobj.ReadCalls = 0;
+    superobj.MapSyncs = 0;
+    superobj.MapDirtyBlocks = 0;
+
+    printf("Marvellous CVFS : Super block gets initialised succesfully\n");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReserveMemory
+//  Description :       It is used to reserve address space which
+//                      gets physical memory only when touched
+//  Input :             Size in bytes
+//  Output :            Address of memory or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * ReserveMemory(
+                        long long size      // Size in bytes
+                    )
+{
+    void *ptr = mmap(NULL,size,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,-1,0);
+
+    return (ptr == MAP_FAILED) ? NULL : ptr;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CreateDILB
+//  Description :       It is used to reserve address space of
+//                      inodes. Inodes are initialised only when
+//                      they are needed, so boot time and memory
+//                      do not depend on MAXINODE.
+//  Author :            Shravani Kishor Darandale
+//  Date :              13/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void CreateDILB()
+{
+    InodeTable = (PINODE)ReserveMemory((long long)MAXINODE * sizeof(INODE));
+    InodeColdTable = (PINODECOLD)ReserveMemory((long long)MAXINODE * sizeof(INODECOLD));
+
+    if((InodeTable == NULL) || (InodeColdTable == NULL))
+    {
+        printf("Marvellous CVFS : Unable to reserve DILB\n");
+        exit(EXIT_FAILURE);
+    }
+
+    superobj.ReadyInodes = 0;
+
+    printf("Marvellous CVFS : DILB created succesfully\n");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ColdInode
+//  Description :       It is used to get cold part of inode
+//  Input :             Inode
+//  Output :            Cold part of inode
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINODECOLD ColdInode(
+                        PINODE inode    // Inode
+                    )
+{
+    return &InodeColdTable[inode - InodeTable];
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TouchInode
+//  Description :       It is used to stamp inode with current tick
+//                      of tier clock, readers stamp it while holding
+//                      only read lock so it is stored atomically
+//  Input :             Inode
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void TouchInode(
+                    PINODE inode    // Inode
+               )
+{
+    __atomic_store_n(&ColdInode(inode)->LastAccess,__atomic_load_n(&Tier.Clock,__ATOMIC_RELAXED),__ATOMIC_RELAXED);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     NextInode
+//  Description :       It is used to walk over initialised inodes
+//  Input :             Inode
+//  Output :            Next inode or NULL after the last one
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINODE NextInode(
+                    PINODE inode    // Inode
+                )
+{
+    if(inode - InodeTable + 1 >= superobj.ReadyInodes)
+    {
+        return NULL;
+    }
+
+    return inode + 1;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ExtendDILB
+//  Description :       It is used to initialise next INODEBATCH
+//                      inodes of reserved DILB. Lock must be held
+//                      for write.
+//  Input :             Nothing
+//  Output :            First new inode or NULL if DILB is full
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINODE ExtendDILB()
+{
+    PINODE newn = NULL;
+    int iFirst = superobj.ReadyInodes;
+    int i = 0;
+
+    if(iFirst == MAXINODE)
+    {
+        return NULL;
+    }
+
+    for(i = iFirst; (i < iFirst + INODEBATCH) && (i < MAXINODE); i++)
+    {
+        newn = &InodeTable[i];
+
+        newn->InodeNumber = i + 1;
+        newn->FileSize = 0;
+        newn->ActualFileSize = 0;
+        newn->Blocks = 0;
+        newn->FileType = 0;
+        newn->LinkCount = 0;
+        newn->ReferenceCount = 0;
+        newn->Permission = 0;
+        newn->BlockMap = NULL;
+
+        ColdInode(newn)->BlockMapSize = 0;
+        ColdInode(newn)->HugeNext = -1;
+        ColdInode(newn)->HugeLeft = 0;
+        ColdInode(newn)->Fifo = NULL;
+        ColdInode(newn)->Owner = NULL;
+        ColdInode(newn)->Changes = 0;
+        ColdInode(newn)->LastAccess = 0;
+        ColdInode(newn)->Spilled = false;
+        ColdInode(newn)->TierStart = -1;
+        ColdInode(newn)->Entries = NULL;
+        ColdInode(newn)->SizeNode = NULL;
+        ColdInode(newn)->SizeStale = false;
+        ColdInode(newn)->NextStale = NULL;
+        ColdInode(newn)->Locking = NULL;
+        ColdInode(newn)->CheckpointDirty = false;
+        ColdInode(newn)->CheckpointAll = false;
+        ColdInode(newn)->NextDirty = NULL;
+        ColdInode(newn)->DirtyBlocks = NULL;
+        ColdInode(newn)->DirtyBytes = 0;
+        ColdInode(newn)->MinSize = 0;
+    }
+
+    superobj.ReadyInodes = i;
+
+    if(head == NULL)
+    {
+        head = InodeTable;
+    }
+
+    return &InodeTable[iFirst];
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AllocateInode
+//  Description :       It is used to find unused inode. DILB is
+//                      extended only when all initialised inodes
+//                      are in use. Lock must be held for write.
+//  Input :             Nothing
+//  Output :            Unused inode or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINODE AllocateInode()
+{
+    PINODE temp = head;
+    EVENT_SCOPE(EV_ALLOCINODE,0);
+
+    while((temp != NULL) && (temp->FileType != 0))
+    {
+        temp = NextInode(temp);
+    }
+
+    if(temp == NULL)
+    {
+        temp = ExtendDILB();
+    }
+
+    return temp;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseCRC32C
+//  Description :       It is used to build the lookup table of
+//                      software CRC32C and to check whether CPU
+//                      supports the SSE4.2 crc32 instruction
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseCRC32C()
+{
+    unsigned int crc = 0;
+    int i = 0, j = 0;
+
+    for(i = 0; i < 256; i++)
+    {
+        crc = i;
+
+        for(j = 0; j < 8; j++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ CRC32CPOLY) : (crc >> 1);
+        }
+        CRC32CTable[i] = crc;
+    }
+
+#ifdef CVFS_X86
+    __builtin_cpu_init();
+    CRC32CHardware = __builtin_cpu_supports("sse4.2");
+#endif
+
+    printf("Marvellous CVFS : CRC32C initialised succesfully (%s)\n",CRC32CHardware ? "hardware" : "software");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseSearch
+//  Description :       It is used to choose widest instruction set
+//                      of this CPU for search once, before search
+//                      threads and jobs can run
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseSearch()
+{
+#ifdef CVFS_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx2"))
+    {
+        SearchLevel = 2;
+    }
+    else if(__builtin_cpu_supports("sse2"))
+    {
+        SearchLevel = 1;
+    }
+#endif
+
+    printf("Marvellous CVFS : Search initialised succesfully (%s)\n",(SearchLevel == 2) ? "AVX2" : ((SearchLevel == 1) ? "SSE2" : "scalar"));
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CRC32CSoftware
+//  Description :       It is used to calculate CRC32C byte by byte
+//  Input :             Data and its length
+//  Output :            Checksum
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+unsigned int CRC32CSoftware(
+                                const char *data,   // Data of block
+                                int length          // Length of data
+                           )
+{
+    unsigned int crc = 0xFFFFFFFF;
+    int i = 0;
+
+    for(i = 0; i < length; i++)
+    {
+        crc = CRC32CTable[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+#ifdef CVFS_X86
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CRC32CSSE42
+//  Description :       It is used to calculate CRC32C using the
+//                      crc32 instruction, 8 bytes at a time
+//  Input :             Data and its length
+//  Output :            Checksum
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+__attribute__((target("sse4.2")))
+unsigned int CRC32CSSE42(
+                            const char *data,   // Data of block
+                            int length          // Length of data
+                        )
+{
+    unsigned int crc = 0xFFFFFFFF;
+
+#ifdef __x86_64__
+    unsigned long long crc64 = crc;
+    unsigned long long Value = 0;
+
+    while(length >= 8)
+    {
+        memcpy(&Value,data,8);
+        crc64 = _mm_crc32_u64(crc64,Value);
+        data = data + 8;
+        length = length - 8;
+    }
+    crc = (unsigned int)crc64;
+#endif
+
+    while(length > 0)
+    {
+        crc = _mm_crc32_u8(crc,(unsigned char)*data);
+        data++;
+        length--;
+    }
+
+    return ~crc;
+}
+
+#endif
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CalculateCRC32C
+//  Description :       It is used to calculate CRC32C using the
+//                      hardware instruction if it is available
+//  Input :             Data and its length
+//  Output :            Checksum
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+unsigned int CalculateCRC32C(
+                                const char *data,   // Data of block
+                                int length          // Length of data
+                            )
+{
+#ifdef CVFS_X86
+    if(CRC32CHardware == true)
+    {
+        return CRC32CSSE42(data,length);
+    }
+#endif
+
+    return CRC32CSoftware(data,length);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseBlockPool
+//  Description :       It is used to reserve address space of
+//                      block pool and its bookkeeping arrays.
+//                      If POOLSIZE can not be reserved, half of
+//                      it is tried again.
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseBlockPool()
+{
+    long long lSize = POOLSIZE;
+    char *ptr = NULL;
+    int i = 0;
+
+    while(lSize >= 16LL * HUGEPAGESIZE)
+    {
+        // One extra huge page to align the base
+        ptr = (char *)ReserveMemory(lSize + HUGEPAGESIZE);
+
+        if(ptr != NULL)
+        {
+            break;
+        }
+        lSize = lSize / 2;
+    }
+
+    if(ptr == NULL)
+    {
+        printf("Marvellous CVFS : Unable to reserve block pool\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Pool.Base = (char *)(((unsigned long)ptr + HUGEPAGESIZE - 1) & ~((unsigned long)HUGEPAGESIZE - 1));
+    Pool.TotalChunks = lSize / HUGEPAGESIZE;
+    Pool.TotalBlocks = (long long)Pool.TotalChunks * CHUNKBLOCKS;
+    Pool.UsedBlocks = 0;
+    Pool.SmallNext = 0;
+    Pool.BuddyNext = (long long *)ReserveMemory(Pool.TotalBlocks * sizeof(long long));
+    Pool.BuddyPrev = (long long *)ReserveMemory(Pool.TotalBlocks * sizeof(long long));
+    Pool.BuddyOrder = (char *)ReserveMemory(Pool.TotalBlocks);
+    Pool.FreeSmall = 0;
+    Pool.HugeTop = Pool.TotalChunks;
+    Pool.FreeChunks = (int *)malloc(Pool.TotalChunks * sizeof(int));
+    Pool.FreeChunkCount = 0;
+    Pool.ChunkUsed = (int *)calloc(Pool.TotalChunks,sizeof(int));
+    Pool.ChunkType = (char *)calloc(Pool.TotalChunks,sizeof(char));
+    Pool.HugeChunks = 0;
+    Pool.HugePageMode = HUGEPAGE_TRANSPARENT;
+    Pool.Checksum = (unsigned int *)ReserveMemory(Pool.TotalBlocks * sizeof(unsigned int));
+    Pool.Shares = (unsigned int *)ReserveMemory(Pool.TotalBlocks * sizeof(unsigned int));
+    Pool.SharedBlocks = 0;
+    Pool.Copies = 0;
+    Pool.CopiedOnWrite = 0;
+    Pool.DefragEnabled = true;
+
+    for(i = 0; i < BUDDYORDERS; i++)
+    {
+        Pool.FreeHead[i] = -1;
+        Pool.FreeCount[i] = 0;
+    }
+
+    // Small files must not waste a whole huge page each
+    madvise(Pool.Base,lSize,MADV_NOHUGEPAGE);
+
+    memset(Pool.Base,0,BLOCKSIZE);
+    Pool.ZeroChecksum = CalculateCRC32C(Pool.Base,BLOCKSIZE);
+
+    printf("Marvellous CVFS : Block pool of %lld MB reserved succesfully\n",lSize / (1024 * 1024));
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BlockAddress
+//  Description :       It is used to get address of pool block
+//  Input :             Block number
+//  Output :            Address of block
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+char * BlockAddress(
+                        long long block     // Block number
+                   )
+{
+    return Pool.Base + (block * BLOCKSIZE);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CacheBucket
+//  Description :       It is used to calculate bucket of image
+//                      block in page cache index
+//  Input :             Block number
+//  Output :            Bucket number
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+unsigned int CacheBucket(
+                            long long block     // Block number
+                        )
+{
+    return (unsigned int)(((unsigned long long)block * 0x9E3779B97F4A7C15ULL) >> (64 - CACHEHASHBITS));
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FrameAddress
+//  Description :       It is used to get address of cache frame
+//  Input :             Frame number
+//  Output :            Address of frame
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+char * FrameAddress(
+                        int frame   // Frame number
+                   )
+{
+    return Cache.Frames + ((long long)frame * BLOCKSIZE);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LinkFrame
+//  Description :       It is used to add frame at the most recent
+//                      end of given queue of 2Q
+//  Input :             Frame number and queue
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void LinkFrame(
+                int frame,      // Frame number
+                int queue       // CACHE_A1IN or CACHE_AM
+              )
+{
+    PCACHEFRAME f = &Cache.Info[frame];
+    int *pHead = (queue == CACHE_A1IN) ? &Cache.A1inHead : &Cache.AmHead;
+    int *pTail = (queue == CACHE_A1IN) ? &Cache.A1inTail : &Cache.AmTail;
+
+    f->Queue = queue;
+    f->prev = -1;
+    f->next = *pHead;
+
+    if(*pHead != -1)
+    {
+        Cache.Info[*pHead].prev = frame;
+    }
+    else
+    {
+        *pTail = frame;
+    }
+    *pHead = frame;
+
+    if(queue == CACHE_A1IN)
+    {
+        Cache.A1inSize++;
+    }
+    else
+    {
+        Cache.AmSize++;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnlinkFrame
+//  Description :       It is used to remove frame from its queue
+//  Input :             Frame number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void UnlinkFrame(
+                    int frame   // Frame number
+                )
+{
+    PCACHEFRAME f = &Cache.Info[frame];
+    int *pHead = (f->Queue == CACHE_A1IN) ? &Cache.A1inHead : &Cache.AmHead;
+    int *pTail = (f->Queue == CACHE_A1IN) ? &Cache.A1inTail : &Cache.AmTail;
+
+    if(f->Queue == CACHE_FREE)
+    {
+        return;
+    }
+
+    if(f->prev != -1)
+    {
+        Cache.Info[f->prev].next = f->next;
+    }
+    else
+    {
+        *pHead = f->next;
+    }
+
+    if(f->next != -1)
+    {
+        Cache.Info[f->next].prev = f->prev;
+    }
+    else
+    {
+        *pTail = f->prev;
+    }
+
+    if(f->Queue == CACHE_A1IN)
+    {
+        Cache.A1inSize--;
+    }
+    else
+    {
+        Cache.AmSize--;
+    }
+
+    f->Queue = CACHE_FREE;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LookupFrame
+//  Description :       It is used to search frame holding block
+//  Input :             Block number
+//  Output :            Frame number or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int LookupFrame(
+                    long long block     // Block number
+               )
+{
+    int f = Cache.Hash[CacheBucket(block)];
+
+    while((f != -1) && (Cache.Info[f].Block != block))
+    {
+        f = Cache.Info[f].hnext;
+    }
+
+    return f;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnhashFrame
+//  Description :       It is used to remove frame from index and
+//                      mark it as holding no block
+//  Input :             Frame number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void UnhashFrame(
+                    int frame   // Frame number
+                )
+{
+    int *ptr = &Cache.Hash[CacheBucket(Cache.Info[frame].Block)];
+
+    while(*ptr != frame)
+    {
+        ptr = &Cache.Info[*ptr].hnext;
+    }
+    *ptr = Cache.Info[frame].hnext;
+
+    Cache.Info[frame].Block = -1;
+    Cache.Info[frame].Dirty = false;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LookupGhost
+//  Description :       It is used to check whether block was
+//                      evicted from A1in recently
+//  Input :             Block number
+//  Output :            Slot of ghost ring or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int LookupGhost(
+                    long long block     // Block number
+               )
+{
+    int g = Cache.GhostHash[CacheBucket(block)];
+
+    while((g != -1) && (Cache.GhostBlock[g] != block))
+    {
+        g = Cache.GhostNext[g];
+    }
+
+    return g;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RemoveGhost
+//  Description :       It is used to forget one ghost. Its slot
+//                      stays in ring until the ring moves past it.
+//  Input :             Slot of ghost ring
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void RemoveGhost(
+                    int ghost   // Slot of ghost ring
+                )
+{
+    int *ptr = &Cache.GhostHash[CacheBucket(Cache.GhostBlock[ghost])];
+
+    while(*ptr != ghost)
+    {
+        ptr = &Cache.GhostNext[*ptr];
+    }
+    *ptr = Cache.GhostNext[ghost];
+
+    Cache.GhostBlock[ghost] = -1;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TrimGhosts
+//  Description :       It is used to drop oldest ghosts so that
+//                      A1out remembers at most given number
+//  Input :             Maximum number of ghosts
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void TrimGhosts(
+                    int limit   // Maximum number of ghosts
+               )
+{
+    while(Cache.GhostSize > limit)
+    {
+        if(Cache.GhostBlock[Cache.GhostStart] != -1)
+        {
+            RemoveGhost(Cache.GhostStart);
+        }
+
+        Cache.GhostStart = (Cache.GhostStart + 1) % (MAXCACHEFRAMES / 2);
+        Cache.GhostSize--;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AddGhost
+//  Description :       It is used to remember block evicted from
+//                      A1in. A1out holds half as many blocks as
+//                      the budget has frames.
+//  Input :             Block number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void AddGhost(
+                long long block     // Block number
+             )
+{
+    unsigned int iBucket = CacheBucket(block);
+    int g = 0;
+
+    if(Cache.Limit / 2 == 0)
+    {
+        return;
+    }
+
+    TrimGhosts(Cache.Limit / 2 - 1);
+
+    g = (Cache.GhostStart + Cache.GhostSize) % (MAXCACHEFRAMES / 2);
+
+    Cache.GhostBlock[g] = block;
+    Cache.GhostNext[g] = Cache.GhostHash[iBucket];
+    Cache.GhostHash[iBucket] = g;
+    Cache.GhostSize++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WriteBackRun
+//  Description :       It is used to write dirty frames holding
+//                      consecutive blocks of image in one call
+//  Input :             Frame numbers in order of block and count
+//  Output :            Number of frames written
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int WriteBackRun(
+                    int *frames,    // Frames in order of block
+                    int count       // Number of frames
+                )
+{
+    struct iovec Vector[MAXIOVECS];
+    ssize_t iRet = 0;
+    int i = 0;
+
+    if(count <= 0)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        Vector[i].iov_base = FrameAddress(frames[i]);
+        Vector[i].iov_len = BLOCKSIZE;
+    }
+
+    iRet = pwritev(Cache.ImageFd,Vector,count,Cache.Info[frames[0]].Block * BLOCKSIZE);
+
+    if(iRet != (ssize_t)count * BLOCKSIZE)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        Cache.Info[frames[i]].Dirty = false;
+    }
+
+    Cache.Writebacks = Cache.Writebacks + count;
+    Cache.WriteOps++;
+
+    return count;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WriteBackFrame
+//  Description :       It is used to write dirty frame to image
+//                      together with dirty frames of neighbouring
+//                      blocks, so that eviction during a long
+//                      write still writes in large calls
+//  Input :             Frame number
+//  Output :            EXECUTE_SUCCESS or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int WriteBackFrame(
+                    int frame   // Frame number
+                  )
+{
+    int Run[MAXIOVECS];
+    long long lFirst = Cache.Info[frame].Block;
+    int f = 0, n = 0;
+
+    while(lFirst > Cache.Info[frame].Block - (MAXIOVECS / 2))
+    {
+        f = LookupFrame(lFirst - 1);
+
+        if((f == -1) || (Cache.Info[f].Dirty == false) || (Cache.Info[f].Pins != 0))
+        {
+            break;
+        }
+        lFirst--;
+    }
+
+    for(n = 0; n < MAXIOVECS; n++)
+    {
+        f = (lFirst + n == Cache.Info[frame].Block) ? frame : LookupFrame(lFirst + n);
+
+        if((f == -1) || (Cache.Info[f].Dirty == false) || ((f != frame) && (Cache.Info[f].Pins != 0)))
+        {
+            break;
+        }
+        Run[n] = f;
+    }
+
+    return (WriteBackRun(Run,n) == n) ? EXECUTE_SUCCESS : ERR_INSUFFICIENT_SPACE;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReclaimFrame
+//  Description :       It is used to evict least recently used
+//                      unpinned frame. A1in gives up its frames
+//                      while it holds more than a quarter of
+//                      budget, Am gives them up otherwise.
+//  Input :             Nothing
+//  Output :            Frame number or -1 if all are pinned
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ReclaimFrame()
+{
+    int iQueue[2] = {CACHE_A1IN,CACHE_AM};
+    int f = -1, i = 0;
+
+    if((Cache.A1inSize <= Cache.Limit / 4) && (Cache.AmSize > 0))
+    {
+        iQueue[0] = CACHE_AM;
+        iQueue[1] = CACHE_A1IN;
+    }
+
+    for(i = 0; i < 2; i++)
+    {
+        f = (iQueue[i] == CACHE_A1IN) ? Cache.A1inTail : Cache.AmTail;
+
+        while(f != -1)
+        {
+            if((Cache.Info[f].Pins == 0) &&
+               ((Cache.Info[f].Dirty == false) || (WriteBackFrame(f) == EXECUTE_SUCCESS)))
+            {
+                if(iQueue[i] == CACHE_A1IN)
+                {
+                    AddGhost(Cache.Info[f].Block);
+                }
+
+                UnlinkFrame(f);
+                UnhashFrame(f);
+                Cache.Evictions++;
+
+                return f;
+            }
+
+            f = Cache.Info[f].prev;
+        }
+    }
+
+    return -1;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TakeFrame
+//  Description :       It is used to get an empty frame, by
+//                      eviction if budget is used up
+//  Input :             Nothing
+//  Output :            Frame number
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int TakeFrame()
+{
+    int f = -1;
+
+    if(Cache.InUse >= Cache.Limit)
+    {
+        f = ReclaimFrame();
+
+        if(f != -1)
+        {
+            return f;
+        }
+        // All frames are pinned, exceed the budget for a moment
+    }
+
+    if(Cache.FreeCount > 0)
+    {
+        Cache.FreeCount--;
+        f = Cache.FreeFrames[Cache.FreeCount];
+    }
+    else
+    {
+        f = Cache.NeverUsed;
+        Cache.NeverUsed++;
+    }
+
+    Cache.InUse++;
+
+    return f;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InsertFrame
+//  Description :       It is used to enter frame holding block in
+//                      index and in A1in, or in Am if block was
+//                      evicted from A1in recently
+//  Input :             Frame number and block number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InsertFrame(
+                    int frame,          // Frame number
+                    long long block     // Block number
+                )
+{
+    unsigned int iBucket = CacheBucket(block);
+    int g = LookupGhost(block);
+
+    Cache.Info[frame].Block = block;
+    Cache.Info[frame].Pins = 0;
+    Cache.Info[frame].hnext = Cache.Hash[iBucket];
+    Cache.Hash[iBucket] = frame;
+
+    if(g != -1)
+    {
+        RemoveGhost(g);
+        LinkFrame(frame,CACHE_AM);
+    }
+    else
+    {
+        LinkFrame(frame,CACHE_A1IN);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     GetBlock
+//  Description :       It is used to get address of data of block
+//                      and pin it till PutBlock. In memory mode
+//                      block lives in pool, else it is brought in
+//                      page cache from image. CACHE_NEW gives zero
+//                      filled frame without reading image.
+//  Input :             Block number and CACHE_xxx flag
+//  Output :            Address of data of block
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+char * GetBlock(
+                    long long block,    // Block number
+                    int flags           // CACHE_READ or CACHE_NEW
+               )
+{
+    ssize_t iRead = 0;
+    int f = 0;
+
+    if(Cache.ImageFd == -1)
+    {
+        return BlockAddress(block);
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    f = LookupFrame(block);
+
+    if(f != -1)
+    {
+        if(flags == CACHE_NEW)
+        {
+            memset(FrameAddress(f),0,BLOCKSIZE);
+            Cache.Info[f].Dirty = true;
+        }
+        else
+        {
+            Cache.Hits++;
+        }
+
+        // Hit in A1in does not make block hot, 2Q waits for a ghost hit
+        if(Cache.Info[f].Queue == CACHE_AM)
+        {
+            UnlinkFrame(f);
+            LinkFrame(f,CACHE_AM);
+        }
+    }
+    else
+    {
+        f = TakeFrame();
+
+        if(flags == CACHE_NEW)
+        {
+            memset(FrameAddress(f),0,BLOCKSIZE);
+            Cache.Info[f].Dirty = true;
+        }
+        else
+        {
+            Cache.Misses++;
+
+            // Part of image which is never written reads as zeros
+            iRead = pread(Cache.ImageFd,FrameAddress(f),BLOCKSIZE,block * BLOCKSIZE);
+
+            if(iRead < 0)
+            {
+                iRead = 0;
+            }
+            memset(FrameAddress(f) + iRead,0,BLOCKSIZE - iRead);
+
+            Cache.Info[f].Dirty = false;
+            Cache.ReadOps++;
+            Cache.ReadBlocks++;
+        }
+
+        InsertFrame(f,block);
+    }
+
+    Cache.Info[f].Pins++;
+
+    pthread_mutex_unlock(&CacheLock);
+
+    return FrameAddress(f);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     PutBlock
+//  Description :       It is used to unpin block taken by GetBlock
+//  Input :             Address given by GetBlock and whether
+//                      data of block is modified
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void PutBlock(
+                char *data,     // Address given by GetBlock
+                bool dirty      // Data is modified
+             )
+{
+    int f = 0;
+
+    if(Cache.ImageFd == -1)
+    {
+        return;
+    }
+
+    f = (data - Cache.Frames) / BLOCKSIZE;
+
+    pthread_mutex_lock(&CacheLock);
+
+    Cache.Info[f].Pins--;
+
+    if(dirty == true)
+    {
+        Cache.Info[f].Dirty = true;
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DropBlock
+//  Description :       It is used to forget cached data of freed
+//                      block without writing it back
+//  Input :             Block number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DropBlock(
+                long long block     // Block number
+              )
+{
+    int f = 0;
+
+    if(Cache.ImageFd == -1)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    f = LookupFrame(block);
+
+    if((f != -1) && (Cache.Info[f].Pins == 0))
+    {
+        UnlinkFrame(f);
+        UnhashFrame(f);
+
+        Cache.FreeFrames[Cache.FreeCount] = f;
+        Cache.FreeCount++;
+        Cache.InUse--;
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     PrefetchBlocks
+//  Description :       It is used to bring blocks of file in page
+//                      cache before they are asked for. Blocks
+//                      which are consecutive in image are read by
+//                      one call. Cached blocks are skipped.
+//  Input :             Inode, first block of file and count
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void PrefetchBlocks(
+                        PINODE inode,       // Inode of file
+                        long long first,    // First block of file
+                        long long count     // Number of blocks
+                   )
+{
+    struct iovec Vector[MAXIOVECS];
+    long long lLast = first + count;
+    long long lBlock = first, lStart = 0, lHave = 0;
+    ssize_t iRead = 0;
+    int f = 0, n = 0, i = 0;
+
+    if(Cache.ImageFd == -1)
+    {
+        return;
+    }
+
+    if(lLast > inode->FileSize / BLOCKSIZE)
+    {
+        lLast = inode->FileSize / BLOCKSIZE;
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    while(lBlock < lLast)
+    {
+        if((inode->BlockMap[lBlock] == HOLEBLOCK) || (LookupFrame(inode->BlockMap[lBlock]) != -1))
+        {
+            lBlock++;
+            continue;
+        }
+
+        lStart = inode->BlockMap[lBlock];
+        n = 0;
+
+        while((lBlock < lLast) && (n < MAXIOVECS) &&
+              (inode->BlockMap[lBlock] == lStart + n) && (LookupFrame(inode->BlockMap[lBlock]) == -1))
+        {
+            f = TakeFrame();
+            InsertFrame(f,inode->BlockMap[lBlock]);
+            Cache.Info[f].Dirty = false;
+
+            // Frames of this run must survive eviction by the rest of run
+            Cache.Info[f].Pins = 1;
+
+            Vector[n].iov_base = FrameAddress(f);
+            Vector[n].iov_len = BLOCKSIZE;
+
+            n++;
+            lBlock++;
+        }
+
+        iRead = preadv(Cache.ImageFd,Vector,n,lStart * BLOCKSIZE);
+
+        if(iRead < 0)
+        {
+            iRead = 0;
+        }
+
+        for(i = 0; i < n; i++)
+        {
+            f = ((char *)Vector[i].iov_base - Cache.Frames) / BLOCKSIZE;
+            lHave = iRead - ((long long)i * BLOCKSIZE);
+
+            // Part of image which is never written reads as zeros
+            if(lHave < 0)
+            {
+                lHave = 0;
+            }
+            if(lHave < BLOCKSIZE)
+            {
+                memset(FrameAddress(f) + lHave,0,BLOCKSIZE - lHave);
+            }
+
+            Cache.Info[f].Pins = 0;
+        }
+
+        Cache.ReadOps++;
+        Cache.ReadBlocks = Cache.ReadBlocks + n;
+        Cache.Prefetched = Cache.Prefetched + n;
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CompareFrameBlocks
+//  Description :       It is used by qsort to order frames by
+//                      the block they hold
+//  Input :             Addresses of two frame numbers
+//  Output :            Negative, zero or positive
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CompareFrameBlocks(
+                        const void *first,  // First frame number
+                        const void *second  // Second frame number
+                      )
+{
+    long long lFirst = Cache.Info[*(const int *)first].Block;
+    long long lSecond = Cache.Info[*(const int *)second].Block;
+
+    return (lFirst > lSecond) - (lFirst < lSecond);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FlushCache
+//  Description :       It is used to write back all dirty frames
+//                      which are not pinned. Frames are sorted by
+//                      block so that consecutive blocks go to
+//                      image in one call.
+//  Input :             Nothing
+//  Output :            Number of frames written
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int FlushCache()
+{
+    int *Dirty = NULL;
+    int f = 0, iCount = 0, iWritten = 0;
+    int i = 0, j = 0;
+
+    if(Cache.ImageFd == -1)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    Dirty = (int *)malloc((Cache.NeverUsed + 1) * sizeof(int));
+
+    for(f = 0; f < Cache.NeverUsed; f++)
+    {
+        if((Cache.Info[f].Queue != CACHE_FREE) && (Cache.Info[f].Dirty == true) && (Cache.Info[f].Pins == 0))
+        {
+            Dirty[iCount] = f;
+            iCount++;
+        }
+    }
+
+    qsort(Dirty,iCount,sizeof(int),CompareFrameBlocks);
+
+    for(i = 0; i < iCount; i = j)
+    {
+        j = i + 1;
+
+        while((j < iCount) && (j - i < MAXIOVECS) && (Cache.Info[Dirty[j]].Block == Cache.Info[Dirty[j - 1]].Block + 1))
+        {
+            j++;
+        }
+
+        iWritten = iWritten + WriteBackRun(&Dirty[i],j - i);
+    }
+
+    free(Dirty);
+
+    pthread_mutex_unlock(&CacheLock);
+
+    return iWritten;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FlusherThread
+//  Description :       It is the entry point of flusher thread.
+//                      It writes back dirty frames periodically
+//                      so that eviction seldom waits for a write.
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * FlusherThread(
+                        void *arg   // Not used
+                    )
+{
+    (void)arg;
+
+    while(1)
+    {
+        usleep(FLUSHINTERVAL * 1000);
+
+        FlushCache();
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialisePageCache
+//  Description :       It is used to open the on disk image and to
+//                      reserve frames of page cache. Without image
+//                      data of files lives in block pool itself.
+//  Input :             Name of image and budget in MB
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialisePageCache(
+                            const char *image,  // Name of image or NULL
+                            int megabytes       // Memory budget
+                        )
+{
+    int fd = -1;
+
+    Cache.ImageFd = -1;
+    Cache.ImageName = NULL;
+
+    if(image == NULL)
+    {
+        return;
+    }
+
+    fd = open(image,O_RDWR | O_CREAT,0644);
+
+    if(fd == -1)
+    {
+        printf("Marvellous CVFS : Unable to open image %s, data is kept in memory\n",image);
+        return;
+    }
+
+    if((megabytes <= 0) || ((long long)megabytes * 1024 * 1024 > MAXCACHESIZE))
+    {
+        megabytes = CACHESIZE / (1024 * 1024);
+    }
+
+    Cache.Frames = (char *)ReserveMemory(MAXCACHESIZE);
+    Cache.Info = (PCACHEFRAME)ReserveMemory(MAXCACHEFRAMES * sizeof(CACHEFRAME));
+    Cache.Hash = (int *)malloc((1 << CACHEHASHBITS) * sizeof(int));
+    Cache.FreeFrames = (int *)ReserveMemory(MAXCACHEFRAMES * sizeof(int));
+    Cache.FreeCount = 0;
+    Cache.NeverUsed = 0;
+    Cache.Limit = megabytes * ((1024 * 1024) / BLOCKSIZE);
+    Cache.InUse = 0;
+    Cache.A1inHead = Cache.A1inTail = -1;
+    Cache.AmHead = Cache.AmTail = -1;
+    Cache.A1inSize = Cache.AmSize = 0;
+    Cache.GhostBlock = (long long *)ReserveMemory((MAXCACHEFRAMES / 2) * sizeof(long long));
+    Cache.GhostNext = (int *)ReserveMemory((MAXCACHEFRAMES / 2) * sizeof(int));
+    Cache.GhostHash = (int *)malloc((1 << CACHEHASHBITS) * sizeof(int));
+    Cache.GhostStart = 0;
+    Cache.GhostSize = 0;
+    Cache.Hits = 0;
+    Cache.Misses = 0;
+    Cache.Evictions = 0;
+    Cache.Writebacks = 0;
+    Cache.WriteOps = 0;
+    Cache.ReadBlocks = 0;
+    Cache.ReadOps = 0;
+    Cache.Prefetched = 0;
+
+    memset(Cache.Hash,0xFF,(1 << CACHEHASHBITS) * sizeof(int));
+    memset(Cache.GhostHash,0xFF,(1 << CACHEHASHBITS) * sizeof(int));
+
+    Cache.ImageFd = fd;
+    Cache.ImageName = image;
+
+    pthread_create(&FlusherThreadId,NULL,FlusherThread,NULL);
+    pthread_detach(FlusherThreadId);
+
+    printf("Marvellous CVFS : Page cache of %d MB over image %s initialised succesfully\n",megabytes,image);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AllocateChunk
+//  Description :       It is used to take one chunk for large file
+//                      and back it as per current huge page mode
+//  Input :             Nothing
+//  Output :            Chunk number or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int AllocateChunk()
+{
+    int iChunk = 0;
+    char *ptr = NULL;
+    void *pRet = NULL;
+
+    if(Pool.FreeChunkCount > 0)
+    {
+        Pool.FreeChunkCount--;
+        iChunk = Pool.FreeChunks[Pool.FreeChunkCount];
+    }
+    else if((long long)(Pool.HugeTop - 1) * CHUNKBLOCKS >= Pool.SmallNext)
+    {
+        Pool.HugeTop--;
+        iChunk = Pool.HugeTop;
+    }
+    else
+    {
+        return -1;
+    }
+
+    ptr = Pool.Base + ((long long)iChunk * HUGEPAGESIZE);
+    Pool.ChunkType[iChunk] = HUGEPAGE_OFF;
+
+    // Chunk of image is only kept contiguous, page cache holds its data
+    if(Cache.ImageFd != -1)
+    {
+        Pool.ChunkUsed[iChunk] = 1;
+        return iChunk;
+    }
+
+    if(Pool.HugePageMode == HUGEPAGE_EXPLICIT)
+    {
+        // Replace this part of pool with pages of hugetlbfs
+        pRet = mmap(ptr,HUGEPAGESIZE,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB,-1,0);
+
+        if(pRet != MAP_FAILED)
+        {
+            Pool.ChunkType[iChunk] = HUGEPAGE_EXPLICIT;
+        }
+        else
+        {
+            // No huge pages are reserved by OS, use transparent ones
+            mmap(ptr,HUGEPAGESIZE,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE,-1,0);
+        }
+    }
+
+    if((Pool.HugePageMode != HUGEPAGE_OFF) && (Pool.ChunkType[iChunk] == HUGEPAGE_OFF))
+    {
+        if(madvise(ptr,HUGEPAGESIZE,MADV_HUGEPAGE) == 0)
+        {
+            Pool.ChunkType[iChunk] = HUGEPAGE_TRANSPARENT;
+        }
+    }
+
+    if(Pool.ChunkType[iChunk] != HUGEPAGE_OFF)
+    {
+        Pool.HugeChunks++;
+    }
+
+    // Reservation of the file which owns this chunk
+    Pool.ChunkUsed[iChunk] = 1;
+
+    return iChunk;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseChunk
+//  Description :       It is used to drop one reference of chunk.
+//                      Memory of chunk is given back to OS when
+//                      its last block is freed.
+//  Input :             Chunk number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseChunk(
+                    int chunk       // Chunk number
+                 )
+{
+    char *ptr = Pool.Base + ((long long)chunk * HUGEPAGESIZE);
+
+    Pool.ChunkUsed[chunk]--;
+
+    if(Pool.ChunkUsed[chunk] > 0)
+    {
+        return;
+    }
+
+    if(Cache.ImageFd != -1)
+    {
+        Pool.FreeChunks[Pool.FreeChunkCount] = chunk;
+        Pool.FreeChunkCount++;
+        return;
+    }
+
+    if(Pool.ChunkType[chunk] == HUGEPAGE_EXPLICIT)
+    {
+        mmap(ptr,HUGEPAGESIZE,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE,-1,0);
+    }
+    else
+    {
+        madvise(ptr,HUGEPAGESIZE,MADV_DONTNEED);
+    }
+
+    if(Pool.ChunkType[chunk] != HUGEPAGE_OFF)
+    {
+        Pool.HugeChunks--;
+    }
+
+    madvise(ptr,HUGEPAGESIZE,MADV_NOHUGEPAGE);
+    Pool.ChunkType[chunk] = HUGEPAGE_OFF;
+
+    Pool.FreeChunks[Pool.FreeChunkCount] = chunk;
+    Pool.FreeChunkCount++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddyInsert
+//  Description :       It is used to add free buddy to list of
+//                      its order
+//  Input :             First block and order of buddy
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void BuddyInsert(
+                    long long block,    // First block of buddy
+                    int order           // Buddy has 2^order blocks
+                )
+{
+    Pool.BuddyOrder[block] = order + 1;
+    Pool.BuddyPrev[block] = -1;
+    Pool.BuddyNext[block] = Pool.FreeHead[order];
+
+    if(Pool.FreeHead[order] != -1)
+    {
+        Pool.BuddyPrev[Pool.FreeHead[order]] = block;
+    }
+
+    Pool.FreeHead[order] = block;
+    Pool.FreeCount[order]++;
+    Pool.FreeSmall = Pool.FreeSmall + (1LL << order);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddyRemove
+//  Description :       It is used to take free buddy out of list
+//                      of its order
+//  Input :             First block and order of buddy
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void BuddyRemove(
+                    long long block,    // First block of buddy
+                    int order           // Buddy has 2^order blocks
+                )
+{
+    if(Pool.BuddyPrev[block] != -1)
+    {
+        Pool.BuddyNext[Pool.BuddyPrev[block]] = Pool.BuddyNext[block];
+    }
+    else
+    {
+        Pool.FreeHead[order] = Pool.BuddyNext[block];
+    }
+
+    if(Pool.BuddyNext[block] != -1)
+    {
+        Pool.BuddyPrev[Pool.BuddyNext[block]] = Pool.BuddyPrev[block];
+    }
+
+    Pool.BuddyOrder[block] = 0;
+    Pool.FreeCount[order]--;
+    Pool.FreeSmall = Pool.FreeSmall - (1LL << order);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddyAllocate
+//  Description :       It is used to allocate 2^order contiguous
+//                      blocks of small region. Larger buddy is
+//                      split when needed, region grows by one
+//                      chunk when no buddy is large enough.
+//  Input :             Order
+//  Output :            First block or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long BuddyAllocate(
+                            int order       // 2^order blocks
+                       )
+{
+    long long lBlock = 0;
+    int i = order;
+
+    while((i < BUDDYORDERS) && (Pool.FreeHead[i] == -1))
+    {
+        i++;
+    }
+
+    if(i == BUDDYORDERS)
+    {
+        // Small region meets huge region
+        if(Pool.SmallNext + CHUNKBLOCKS > (long long)Pool.HugeTop * CHUNKBLOCKS)
+        {
+            return -1;
+        }
+
+        i = BUDDYORDERS - 1;
+        BuddyInsert(Pool.SmallNext,i);
+        Pool.SmallNext = Pool.SmallNext + CHUNKBLOCKS;
+    }
+
+    lBlock = Pool.FreeHead[i];
+    BuddyRemove(lBlock,i);
+
+    // Upper halves stay free
+    while(i > order)
+    {
+        i--;
+        BuddyInsert(lBlock + (1LL << i),i);
+    }
+
+    return lBlock;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddyTake
+//  Description :       It is used to allocate given block if it
+//                      is free. Free buddy holding it is split
+//                      and all other parts stay free.
+//  Input :             Block number
+//  Output :            true if block is allocated
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool BuddyTake(
+                long long block     // Block number
+              )
+{
+    long long lHead = 0;
+    int i = 0;
+
+    if((block < 0) || (block >= Pool.SmallNext))
+    {
+        return false;
+    }
+
+    for(i = 0; i < BUDDYORDERS; i++)
+    {
+        lHead = block & ~((1LL << i) - 1);
+
+        if(Pool.BuddyOrder[lHead] == i + 1)
+        {
+            break;
+        }
+    }
+
+    if(i == BUDDYORDERS)
+    {
+        return false;
+    }
+
+    BuddyRemove(lHead,i);
+
+    while(i > 0)
+    {
+        i--;
+
+        if(block < lHead + (1LL << i))
+        {
+            BuddyInsert(lHead + (1LL << i),i);
+        }
+        else
+        {
+            BuddyInsert(lHead,i);
+            lHead = lHead + (1LL << i);
+        }
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddySpread
+//  Description :       It is used to allocate first block of
+//                      largest free buddy. File which starts here
+//                      has room to grow, and free neighbours of
+//                      other files are left to them.
+//  Input :             Nothing
+//  Output :            Block number or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long BuddySpread()
+{
+    long long lBlock = 0;
+    int i = BUDDYORDERS - 1;
+
+    while((i >= 0) && (Pool.FreeHead[i] == -1))
+    {
+        i--;
+    }
+
+    if(i < 0)
+    {
+        return BuddyAllocate(0);
+    }
+
+    lBlock = Pool.FreeHead[i];
+    BuddyTake(lBlock);
+
+    return lBlock;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BuddyFree
+//  Description :       It is used to give 2^order blocks back to
+//                      small region. Buddy is merged with its
+//                      free neighbour as long as possible. Memory
+//                      of whole free chunk is given back to OS.
+//  Input :             First block and order
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void BuddyFree(
+                long long block,    // First block
+                int order           // 2^order blocks
+              )
+{
+    long long lBuddy = 0;
+
+    while(order < BUDDYORDERS - 1)
+    {
+        lBuddy = block ^ (1LL << order);
+
+        if(Pool.BuddyOrder[lBuddy] != order + 1)
+        {
+            break;
+        }
+
+        BuddyRemove(lBuddy,order);
+
+        block = block & lBuddy;
+        order++;
+    }
+
+    BuddyInsert(block,order);
+
+    if((order == BUDDYORDERS - 1) && (Cache.ImageFd == -1))
+    {
+        madvise(BlockAddress(block),HUGEPAGESIZE,MADV_DONTNEED);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AllocateBlock
+//  Description :       It is used to allocate one zero filled
+//                      block for given file. Small file gets the
+//                      goal block if it is free, so that data
+//                      written in order stays contiguous.
+//  Input :             Inode of file, goal block or -1
+//  Output :            Block number or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long AllocateBlock(
+                            PINODE inode,       // Inode of file
+                            long long goal      // Preferred block or -1
+                       )
+{
+    long long lBlock = -1;
+    int iChunk = 0;
+    PINODECOLD cold = ColdInode(inode);
+
+    // Large file continues in its own chunk, sparse file is large only by its data
+    if((inode->Blocks * BLOCKSIZE >= HUGEFILESIZE) && (cold->HugeLeft == 0))
+    {
+        iChunk = AllocateChunk();
+
+        if(iChunk != -1)
+        {
+            cold->HugeNext = (long long)iChunk * CHUNKBLOCKS;
+            cold->HugeLeft = CHUNKBLOCKS;
+        }
+    }
+
+    if(cold->HugeLeft > 0)
+    {
+        lBlock = cold->HugeNext;
+        iChunk = lBlock / CHUNKBLOCKS;
+
+        cold->HugeNext++;
+        cold->HugeLeft--;
+        Pool.ChunkUsed[iChunk]++;
+
+        // Whole chunk is used, drop the reservation
+        if(cold->HugeLeft == 0)
+        {
+            cold->HugeNext = -1;
+            ReleaseChunk(iChunk);
+        }
+    }
+    else
+    {
+        lBlock = (BuddyTake(goal) == true) ? goal : BuddySpread();
+
+        if(lBlock == -1)
+        {
+            return -1;
+        }
+
+        // Block may hold data of deleted file
+        if(Cache.ImageFd == -1)
+        {
+            memset(BlockAddress(lBlock),0,BLOCKSIZE);
+        }
+    }
+
+    // Image may hold old data at any block
+    if(Cache.ImageFd != -1)
+    {
+        PutBlock(GetBlock(lBlock,CACHE_NEW),true);
+    }
+
+    Pool.Checksum[lBlock] = Pool.ZeroChecksum;
+    Pool.UsedBlocks++;
+
+    return lBlock;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FreeBlock
+//  Description :       It is used to give block back to pool, or to
+//                      drop one share of block of copied file
+//  Input :             Block number
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FreeBlock(
+                long long block     // Block number
+              )
+{
+    int iChunk = block / CHUNKBLOCKS;
+
+    // Block of copied file stays until its last owner frees it
+    if(Pool.Shares[block] > 0)
+    {
+        Pool.Shares[block]--;
+        Pool.SharedBlocks--;
+        return;
+    }
+
+    DropBlock(block);
+
+    if(iChunk >= Pool.HugeTop)
+    {
+        ReleaseChunk(iChunk);
+    }
+    else
+    {
+        BuddyFree(block,0);
+    }
+
+    Pool.UsedBlocks--;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BlockCount
+//  Description :       It is used to count entries of block map of
+//                      file which are in use, holes included
+//  Input :             Inode of file
+//  Output :            Number of blocks
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long BlockCount(
+                        PINODE inode    // Inode of file
+                    )
+{
+    return inode->FileSize / BLOCKSIZE;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     GrowFile
+//  Description :       It is used to extend block map of file so
+//                      that given size fits in it. New entries are
+//                      holes. Block map grows by doubling.
+//  Input :             Inode of file and required size
+//  Output :            EXECUTE_SUCCESS or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int GrowFile(
+                PINODE inode,       // Inode of file
+                long long size      // Required size
+            )
+{
+    long long lBlocks = (size + BLOCKSIZE - 1) / BLOCKSIZE;
+    long long lNewSize = 0;
+    long long *ptr = NULL;
+    PINODECOLD cold = ColdInode(inode);
+
+    if(lBlocks > cold->BlockMapSize)
+    {
+        lNewSize = (cold->BlockMapSize == 0) ? 1 : cold->BlockMapSize;
+
+        while(lNewSize < lBlocks)
+        {
+            lNewSize = lNewSize * 2;
+        }
+
+        ptr = (long long *)realloc(inode->BlockMap,lNewSize * sizeof(long long));
+
+        if(ptr == NULL)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        inode->BlockMap = ptr;
+        cold->BlockMapSize = lNewSize;
+    }
+
+    while(BlockCount(inode) < lBlocks)
+    {
+        inode->BlockMap[BlockCount(inode)] = HOLEBLOCK;
+        inode->FileSize = inode->FileSize + BLOCKSIZE;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseQuota
+//  Description :       It is used to initialise quota without limits
+//  Input :             Quota and its name
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseQuota(
+                        PQUOTA quota,       // Quota
+                        const char *name    // Name shown by stat
+                    )
+{
+    memset(quota,0,sizeof(QUOTA));
+
+    quota->Name = name;
+
+    pthread_mutex_init(&quota->Lock,NULL);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FoldQuota
+//  Description :       It is used to move usage of all per CPU
+//                      counters into totals of quota. Lock of
+//                      quota must be held.
+//  Input :             Quota
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FoldQuota(
+                PQUOTA quota        // Quota
+              )
+{
+    int i = 0;
+
+    for(i = 0; i < QUOTASLOTS; i++)
+    {
+        quota->Bytes += __atomic_exchange_n(&quota->Slots[i].Bytes,0,__ATOMIC_ACQ_REL);
+        quota->Inodes += __atomic_exchange_n(&quota->Slots[i].Inodes,0,__ATOMIC_ACQ_REL);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ChargeQuota
+//  Description :       It is used to charge usage to quota or to
+//                      give it back when values are negative.
+//                      While usage is far below the limit only
+//                      counter of current CPU is touched. Near
+//                      the limit all counters are folded so the
+//                      limit is exact.
+//  Input :             Quota, bytes and inodes
+//  Output :            EXECUTE_SUCCESS or ERR_QUOTA_EXCEEDED
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ChargeQuota(
+                    PQUOTA quota,       // Quota
+                    long long bytes,    // Bytes to charge
+                    long long inodes    // Inodes to charge
+               )
+{
+    PQUOTASLOT slot = NULL;
+    int iCpu = sched_getcpu();
+    long long lBytes = 0;
+    long long lInodes = 0;
+    bool bFar = true;
+
+    // Folded totals lag behind real usage by at most one batch per slot
+    if((bytes > 0) && (quota->ByteLimit != 0))
+    {
+        lBytes = __atomic_load_n(&quota->Bytes,__ATOMIC_RELAXED);
+        bFar = bFar && (lBytes + bytes + (long long)QUOTASLOTS * QUOTABYTEBATCH <= quota->ByteLimit);
+    }
+
+    if((inodes > 0) && (quota->InodeLimit != 0))
+    {
+        lInodes = __atomic_load_n(&quota->Inodes,__ATOMIC_RELAXED);
+        bFar = bFar && (lInodes + inodes + (long long)QUOTASLOTS * QUOTAINODEBATCH <= quota->InodeLimit);
+    }
+
+    if(bFar == false)
+    {
+        pthread_mutex_lock(&quota->Lock);
+
+        FoldQuota(quota);
+
+        if(((bytes > 0) && (quota->ByteLimit != 0) && (quota->Bytes + bytes > quota->ByteLimit)) ||
+           ((inodes > 0) && (quota->InodeLimit != 0) && (quota->Inodes + inodes > quota->InodeLimit)))
+        {
+            quota->Refused++;
+            pthread_mutex_unlock(&quota->Lock);
+            return ERR_QUOTA_EXCEEDED;
+        }
+
+        quota->Bytes += bytes;
+        quota->Inodes += inodes;
+
+        pthread_mutex_unlock(&quota->Lock);
+        return EXECUTE_SUCCESS;
+    }
+
+    slot = &quota->Slots[(iCpu < 0 ? 0 : iCpu) & (QUOTASLOTS - 1)];
+
+    if(bytes != 0)
+    {
+        lBytes = __atomic_add_fetch(&slot->Bytes,bytes,__ATOMIC_RELAXED);
+    }
+
+    if(inodes != 0)
+    {
+        lInodes = __atomic_add_fetch(&slot->Inodes,inodes,__ATOMIC_RELAXED);
+    }
+
+    // Counter is full, reconcile it with totals
+    if((llabs(lBytes) > QUOTABYTEBATCH) || (llabs(lInodes) > QUOTAINODEBATCH))
+    {
+        pthread_mutex_lock(&quota->Lock);
+
+        quota->Bytes += __atomic_exchange_n(&slot->Bytes,0,__ATOMIC_ACQ_REL);
+        quota->Inodes += __atomic_exchange_n(&slot->Inodes,0,__ATOMIC_ACQ_REL);
+
+        pthread_mutex_unlock(&quota->Lock);
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ChargeFile
+//  Description :       It is used to charge usage of file to
+//                      session which owns it and to directory
+//                      which holds it
+//  Input :             Inode, bytes and inodes
+//  Output :            EXECUTE_SUCCESS or ERR_QUOTA_EXCEEDED
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ChargeFile(
+                PINODE inode,       // Inode of file
+                long long bytes,    // Bytes to charge
+                long long inodes    // Inodes to charge
+              )
+{
+    if((bytes == 0) && (inodes == 0))
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    if(ChargeQuota(ColdInode(inode)->Owner,bytes,inodes) != EXECUTE_SUCCESS)
+    {
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    if(ChargeQuota(&DirectoryQuota,bytes,inodes) != EXECUTE_SUCCESS)
+    {
+        ChargeQuota(ColdInode(inode)->Owner,-bytes,-inodes);
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnshareBlock
+//  Description :       It is used to give file its own copy of block
+//                      which is shared with copies of file
+//  Input :             Inode and index of block in block map
+//  Output :            EXECUTE_SUCCESS or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int UnshareBlock(
+                    PINODE inode,       // Inode of file
+                    long long index     // Block of file
+                )
+{
+    long long lOld = inode->BlockMap[index];
+    long long lNew = 0;
+    char *src = NULL;
+    char *dst = NULL;
+
+    if(Pool.Shares[lOld] == 0)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    lNew = AllocateBlock(inode,((index > 0) && (inode->BlockMap[index - 1] != HOLEBLOCK)) ? inode->BlockMap[index - 1] + 1 : -1);
+
+    if(lNew == -1)
+    {
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    src = GetBlock(lOld,CACHE_READ);
+    dst = GetBlock(lNew,CACHE_NEW);
+
+    memcpy(dst,src,BLOCKSIZE);
+    Pool.Checksum[lNew] = Pool.Checksum[lOld];
+
+    PutBlock(dst,true);
+    PutBlock(src,false);
+
+    FreeBlock(lOld);
+
+    inode->BlockMap[index] = lNew;
+    ColdInode(inode)->Changes++;
+
+    Pool.CopiedOnWrite++;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FillHoles
+//  Description :       It is used to allocate blocks for holes of
+//                      file inside the range which is to be written.
+//                      Shared blocks of range are made private.
+//  Input :             Inode, offset and size of range
+//  Output :            EXECUTE_SUCCESS or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int FillHoles(
+                PINODE inode,       // Inode of file
+                long long offset,   // Offset of range
+                long long size      // Size of range
+             )
+{
+    long long lBlock = 0;
+    long long lPoolBlock = 0;
+    long long lHoles = 0;
+    EVENT_SCOPE(EV_FILLHOLES,size);
+
+    if(size <= 0)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    for(lBlock = offset / BLOCKSIZE; lBlock <= (offset + size - 1) / BLOCKSIZE; lBlock++)
+    {
+        if(inode->BlockMap[lBlock] == HOLEBLOCK)
+        {
+            lHoles++;
+        }
+    }
+
+    // Whole range is charged once, before any block is taken
+    if(ChargeFile(inode,lHoles * BLOCKSIZE,0) != EXECUTE_SUCCESS)
+    {
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    for(lBlock = offset / BLOCKSIZE; lBlock <= (offset + size - 1) / BLOCKSIZE; lBlock++)
+    {
+        if((inode->BlockMap[lBlock] != HOLEBLOCK) && (UnshareBlock(inode,lBlock) != EXECUTE_SUCCESS))
+        {
+            ChargeFile(inode,-lHoles * BLOCKSIZE,0);
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        if(inode->BlockMap[lBlock] != HOLEBLOCK)
+        {
+            continue;
+        }
+
+        // Block after previous block of file keeps it contiguous
+        lPoolBlock = AllocateBlock(inode,((lBlock > 0) && (inode->BlockMap[lBlock - 1] != HOLEBLOCK)) ? inode->BlockMap[lBlock - 1] + 1 : -1);
+
+        if(lPoolBlock == -1)
+        {
+            ChargeFile(inode,-lHoles * BLOCKSIZE,0);
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        inode->BlockMap[lBlock] = lPoolBlock;
+        inode->Blocks++;
+        lHoles--;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TierAllocate
+//  Description :       It is used to find run of free blocks in
+//                      backing file, first fit, else at its end.
+//                      Lock must be held for write.
+//  Input :             Number of blocks
+//  Output :            First block of run
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long TierAllocate(
+                        long long count     // Number of blocks
+                      )
+{
+    long long lStart = 0;
+    int i = 0;
+
+    for(i = 0; i < Tier.FreeCount; i++)
+    {
+        if(Tier.Free[i].Count >= count)
+        {
+            lStart = Tier.Free[i].Start;
+
+            Tier.Free[i].Start = Tier.Free[i].Start + count;
+            Tier.Free[i].Count = Tier.Free[i].Count - count;
+
+            if(Tier.Free[i].Count == 0)
+            {
+                memmove(&Tier.Free[i],&Tier.Free[i + 1],(Tier.FreeCount - i - 1) * sizeof(TIEREXTENT));
+                Tier.FreeCount--;
+            }
+
+            return lStart;
+        }
+    }
+
+    lStart = Tier.End;
+    Tier.End = Tier.End + count;
+
+    if(Tier.End > Tier.Capacity)
+    {
+        while(Tier.Capacity < Tier.End)
+        {
+            Tier.Capacity = (Tier.Capacity == 0) ? 1024 : Tier.Capacity * 2;
+        }
+
+        Tier.Checksum = (unsigned int *)realloc(Tier.Checksum,Tier.Capacity * sizeof(unsigned int));
+    }
+
+    return lStart;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TierFree
+//  Description :       It is used to give run of blocks back to
+//                      backing file. Neighbouring free runs are
+//                      merged and disk space of run is released.
+//                      Lock must be held for write.
+//  Input :             First block and number of blocks
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void TierFree(
+                long long start,    // First block
+                long long count     // Number of blocks
+             )
+{
+    int i = 0;
+
+    if(count == 0)
+    {
+        return;
+    }
+
+#ifdef FALLOC_FL_PUNCH_HOLE
+    fallocate(Tier.Fd,FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,start * BLOCKSIZE,count * BLOCKSIZE);
+#endif
+
+    while((i < Tier.FreeCount) && (Tier.Free[i].Start < start))
+    {
+        i++;
+    }
+
+    if((i > 0) && (Tier.Free[i - 1].Start + Tier.Free[i - 1].Count == start))
+    {
+        i--;
+        Tier.Free[i].Count = Tier.Free[i].Count + count;
+    }
+    else
+    {
+        if(Tier.FreeCount == Tier.FreeCapacity)
+        {
+            Tier.FreeCapacity = (Tier.FreeCapacity == 0) ? 16 : Tier.FreeCapacity * 2;
+            Tier.Free = (PTIEREXTENT)realloc(Tier.Free,Tier.FreeCapacity * sizeof(TIEREXTENT));
+        }
+
+        memmove(&Tier.Free[i + 1],&Tier.Free[i],(Tier.FreeCount - i) * sizeof(TIEREXTENT));
+        Tier.Free[i].Start = start;
+        Tier.Free[i].Count = count;
+        Tier.FreeCount++;
+    }
+
+    if((i + 1 < Tier.FreeCount) && (Tier.Free[i].Start + Tier.Free[i].Count == Tier.Free[i + 1].Start))
+    {
+        Tier.Free[i].Count = Tier.Free[i].Count + Tier.Free[i + 1].Count;
+        memmove(&Tier.Free[i + 1],&Tier.Free[i + 2],(Tier.FreeCount - i - 2) * sizeof(TIEREXTENT));
+        Tier.FreeCount--;
+    }
+
+    // Free run at end is not kept, file grows there again
+    if(Tier.Free[i].Start + Tier.Free[i].Count == Tier.End)
+    {
+        Tier.End = Tier.Free[i].Start;
+        Tier.FreeCount--;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FaultIn
+//  Description :       It is used to bring data of spilled file
+//                      back from backing file into new pool blocks.
+//                      Lock must be held for write.
+//  Input :             Inode of file
+//  Output :            EXECUTE_SUCCESS, ERR_IO when backing file
+//                      gives less data, or ERR_INSUFFICIENT_SPACE
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int FaultIn(
+                PINODE inode    // Inode of file
+           )
+{
+    PINODECOLD cold = ColdInode(inode);
+    struct iovec Vector[MAXIOVECS];
+    long long *Target = NULL;
+    long long lCount = inode->Blocks;
+    long long i = 0, j = 0;
+    ssize_t iRead = 0;
+    int n = 0;
+
+    if(cold->Spilled == false)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    Target = (long long *)malloc(lCount * sizeof(long long));
+
+    // All blocks are taken first, so failure leaves file spilled
+    for(j = 0; j < lCount; j++)
+    {
+        Target[j] = AllocateBlock(inode,(j == 0) ? -1 : Target[j - 1] + 1);
+
+        if(Target[j] == -1)
+        {
+            break;
+        }
+    }
+
+    for(i = 0; (j == lCount) && (i < lCount); i = i + n)
+    {
+        for(n = 0; (n < MAXIOVECS) && (i + n < lCount); n++)
+        {
+            Vector[n].iov_base = BlockAddress(Target[i + n]);
+            Vector[n].iov_len = BLOCKSIZE;
+        }
+
+        iRead = preadv(Tier.Fd,Vector,n,(cold->TierStart + i) * BLOCKSIZE);
+
+        if(iRead != (ssize_t)n * BLOCKSIZE)
+        {
+            break;
+        }
+    }
+
+    if((j < lCount) || (i < lCount))
+    {
+        while(j > 0)
+        {
+            j--;
+            FreeBlock(Target[j]);
+        }
+
+        free(Target);
+
+        // Short read says nothing about checksums, they are checked when data is read
+        return (i < lCount) ? ERR_IO : ERR_INSUFFICIENT_SPACE;
+    }
+
+    for(i = 0, j = 0; i < BlockCount(inode); i++)
+    {
+        if(inode->BlockMap[i] != HOLEBLOCK)
+        {
+            inode->BlockMap[i] = Target[j];
+            Pool.Checksum[Target[j]] = Tier.Checksum[cold->TierStart + j];
+            j++;
+        }
+    }
+
+    TierFree(cold->TierStart,lCount);
+
+    cold->Spilled = false;
+    cold->TierStart = -1;
+    cold->Changes++;
+    TouchInode(inode);
+
+    Tier.SpilledFiles--;
+    Tier.SpilledBlocks = Tier.SpilledBlocks - lCount;
+    Tier.Faults++;
+    Tier.BlocksIn = Tier.BlocksIn + lCount;
+
+    free(Target);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FreeFileBlocks
+//  Description :       It is used to give all blocks of file and
+//                      its unused chunk back to pool
+//  Input :             Inode of file
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FreeFileBlocks(
+                        PINODE inode    // Inode of file
+                   )
+{
+    long long i = 0;
+    PINODECOLD cold = ColdInode(inode);
+
+    cold->Changes++;
+
+    // Spilled file holds no pool block, only a run of backing file
+    if(cold->Spilled == true)
+    {
+        TierFree(cold->TierStart,inode->Blocks);
+
+        Tier.SpilledFiles--;
+        Tier.SpilledBlocks = Tier.SpilledBlocks - inode->Blocks;
+
+        cold->Spilled = false;
+        cold->TierStart = -1;
+    }
+    else
+    {
+        for(i = 0; i < BlockCount(inode); i++)
+        {
+            if(inode->BlockMap[i] != HOLEBLOCK)
+            {
+                FreeBlock(inode->BlockMap[i]);
+            }
+        }
+    }
+
+    if(cold->HugeLeft > 0)
+    {
+        ReleaseChunk(cold->HugeNext / CHUNKBLOCKS);
+    }
+
+    free(inode->BlockMap);
+
+    inode->BlockMap = NULL;
+    cold->BlockMapSize = 0;
+    cold->HugeNext = -1;
+    cold->HugeLeft = 0;
+    inode->FileSize = 0;
+    inode->Blocks = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CopyToFile
+//  Description :       It is used to copy data into blocks of file.
+//                      Holes of range must be filled already.
+//  Input :             Inode, offset in file, data and its size
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CopyToFile(
+                    PINODE inode,       // Inode of file
+                    long long offset,   // Offset in file
+                    const char *data,   // Data to copy
+                    long long size      // Size of data
+               )
+{
+    long long lChunk = 0;
+    char *ptr = NULL;
+    EVENT_SCOPE(EV_COPYIN,size);
+
+    while(size > 0)
+    {
+        lChunk = BLOCKSIZE - (offset % BLOCKSIZE);
+
+        if(lChunk > size)
+        {
+            lChunk = size;
+        }
+
+        // Whole block is overwritten, old data need not be read
+        ptr = GetBlock(inode->BlockMap[offset / BLOCKSIZE],(lChunk == BLOCKSIZE) ? CACHE_NEW : CACHE_READ);
+        memcpy(ptr + (offset % BLOCKSIZE),data,lChunk);
+        PutBlock(ptr,true);
+
+        offset = offset + lChunk;
+        data = data + lChunk;
+        size = size - lChunk;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CopyFromFile
+//  Description :       It is used to copy data out of blocks of file.
+//                      Holes give zeros.
+//  Input :             Inode, offset in file, buffer and size
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CopyFromFile(
+                    PINODE inode,       // Inode of file
+                    long long offset,   // Offset in file
+                    char *data,         // Buffer to fill
+                    long long size      // Size of data
+                 )
+{
+    long long lChunk = 0;
+    char *ptr = NULL;
+    EVENT_SCOPE(EV_COPYOUT,size);
+
+    while(size > 0)
+    {
+        lChunk = BLOCKSIZE - (offset % BLOCKSIZE);
+
+        if(lChunk > size)
+        {
+            lChunk = size;
+        }
+
+        // Hole reads as zeros without touching any block
+        if(inode->BlockMap[offset / BLOCKSIZE] == HOLEBLOCK)
+        {
+            memset(data,0,lChunk);
+        }
+        else
+        {
+            ptr = GetBlock(inode->BlockMap[offset / BLOCKSIZE],CACHE_READ);
+            memcpy(data,ptr + (offset % BLOCKSIZE),lChunk);
+            PutBlock(ptr,false);
+        }
+
+        offset = offset + lChunk;
+        data = data + lChunk;
+        size = size - lChunk;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UpdateChecksum
+//  Description :       It is used to recalculate checksum of all
+//                      blocks which are touched by the write
+//  Input :             Inode, offset and size of written data
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void UpdateChecksum(
+                        PINODE inode,       // Inode of file
+                        long long offset,   // Offset of data
+                        long long size      // Size of data
+                   )
+{
+    long long lBlock = 0;
+    long long lPoolBlock = 0;
+    char *ptr = NULL;
+    EVENT_SCOPE(EV_CHECKSUM,size);
+
+    ColdInode(inode)->Changes++;
+
+    for(lBlock = offset / BLOCKSIZE; lBlock <= (offset + size - 1) / BLOCKSIZE; lBlock++)
+    {
+        lPoolBlock = inode->BlockMap[lBlock];
+
+        ptr = GetBlock(lPoolBlock,CACHE_READ);
+        Pool.Checksum[lPoolBlock] = CalculateCRC32C(ptr,BLOCKSIZE);
+        PutBlock(ptr,false);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     VerifyChecksum
+//  Description :       It is used to verify checksum of all
+//                      blocks which are touched by the read
+//  Input :             Inode, offset and size of data
+//  Output :            EXECUTE_SUCCESS or ERR_CHECKSUM_MISMATCH
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int VerifyChecksum(
+                        PINODE inode,       // Inode of file
+                        long long offset,   // Offset of data
+                        long long size      // Size of data
+                  )
+{
+    long long lBlock = 0;
+    long long lPoolBlock = 0;
+    unsigned int iCRC = 0;
+    char *ptr = NULL;
+    int iRet = EXECUTE_SUCCESS;
+
+    for(lBlock = offset / BLOCKSIZE; lBlock <= (offset + size - 1) / BLOCKSIZE; lBlock++)
+    {
+        lPoolBlock = inode->BlockMap[lBlock];
+
+        if(lPoolBlock == HOLEBLOCK)
+        {
+            continue;
+        }
+
+        ptr = GetBlock(lPoolBlock,CACHE_READ);
+        iCRC = CalculateCRC32C(ptr,BLOCKSIZE);
+        PutBlock(ptr,false);
+
+        if(iCRC != Pool.Checksum[lPoolBlock])
+        {
+            __sync_fetch_and_add(&superobj.ChecksumErrors,1);
+            superobj.LastBadInode = inode->InodeNumber;
+            superobj.LastBadBlock = lBlock;
+
+            iRet = ERR_CHECKSUM_MISMATCH;
+        }
+    }
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CountExtents
+//  Description :       It is used to count runs of contiguous
+//                      pool blocks which hold data of file
+//  Input :             Inode of file
+//  Output :            Number of extents
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long CountExtents(
+                        PINODE inode    // Inode of file
+                      )
+{
+    long long lExtents = 0;
+    long long lPrev = -2;
+    long long i = 0;
+
+    for(i = 0; i < BlockCount(inode); i++)
+    {
+        if(inode->BlockMap[i] == HOLEBLOCK)
+        {
+            continue;
+        }
+
+        if(inode->BlockMap[i] != lPrev + 1)
+        {
+            lExtents++;
+        }
+
+        lPrev = inode->BlockMap[i];
+    }
+
+    return lExtents;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CanDefragment
+//  Description :       It is used to check whether file is small
+//                      file in many pieces. Large files already
+//                      live in whole chunks.
+//  Input :             Inode of file
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool CanDefragment(
+                    PINODE inode    // Inode of file
+                  )
+{
+    long long i = 0;
+
+    if((inode->FileType != REGULARFILE) || (inode->Blocks < 2) || (ColdInode(inode)->HugeLeft > 0) ||
+       (ColdInode(inode)->Spilled == true))
+    {
+        return false;
+    }
+
+    for(i = 0; i < BlockCount(inode); i++)
+    {
+        // Moving shared block would end its sharing
+        if((inode->BlockMap[i] != HOLEBLOCK) && ((inode->BlockMap[i] >= Pool.SmallNext) || (Pool.Shares[inode->BlockMap[i]] != 0)))
+        {
+            return false;
+        }
+    }
+
+    return (CountExtents(inode) > 1);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AllocateExtent
+//  Description :       It is used to allocate given number of
+//                      contiguous blocks of small region. Buddy
+//                      is rounded up to power of 2 and its unused
+//                      tail is freed again.
+//  Input :             Number of blocks
+//  Output :            First block or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long AllocateExtent(
+                            long long count     // Number of blocks
+                        )
+{
+    long long lFirst = 0;
+    long long i = 0;
+    int iOrder = 0;
+
+    while((1LL << iOrder) < count)
+    {
+        iOrder++;
+    }
+
+    if(iOrder >= BUDDYORDERS)
+    {
+        return -1;
+    }
+
+    lFirst = BuddyAllocate(iOrder);
+
+    if(lFirst == -1)
+    {
+        return -1;
+    }
+
+    for(i = count; i < (1LL << iOrder); i++)
+    {
+        BuddyFree(lFirst + i,0);
+    }
+
+    Pool.UsedBlocks = Pool.UsedBlocks + count;
+
+    return lFirst;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RelocateFile
+//  Description :       It is used to move data of file into one
+//                      new extent. Data is copied under read lock
+//                      so readers are not stopped. Block map is
+//                      switched under write lock only if file is
+//                      not changed meanwhile.
+//  Input :             Inode of file
+//  Output :            true if file is moved
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool RelocateFile(
+                    PINODE inode    // Inode of file
+                 )
+{
+    long long *Source = NULL;
+    long long lMapBlocks = 0;
+    long long lCount = 0;
+    long long lChanges = 0;
+    long long lFirst = 0;
+    long long i = 0, j = 0;
+    char *src = NULL;
+    char *dst = NULL;
+    bool bMoved = false;
+
+    LockFileSystem(true);
+
+    if(CanDefragment(inode) == false)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return false;
+    }
+
+    lMapBlocks = BlockCount(inode);
+    lCount = inode->Blocks;
+    lChanges = ColdInode(inode)->Changes;
+    lFirst = AllocateExtent(lCount);
+
+    if(lFirst == -1)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return false;
+    }
+
+    Source = (long long *)malloc(lMapBlocks * sizeof(long long));
+    memcpy(Source,inode->BlockMap,lMapBlocks * sizeof(long long));
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    // Copy while readers keep going, writers wait
+    LockFileSystem(false);
+
+    for(i = 0, j = 0; i < lMapBlocks; i++)
+    {
+        if(Source[i] == HOLEBLOCK)
+        {
+            continue;
+        }
+
+        src = GetBlock(Source[i],CACHE_READ);
+        dst = GetBlock(lFirst + j,CACHE_NEW);
+
+        memcpy(dst,src,BLOCKSIZE);
+        Pool.Checksum[lFirst + j] = Pool.Checksum[Source[i]];
+
+        PutBlock(dst,true);
+        PutBlock(src,false);
+        j++;
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    LockFileSystem(true);
+
+    if((ColdInode(inode)->Changes == lChanges) && (BlockCount(inode) == lMapBlocks) &&
+       (memcmp(Source,inode->BlockMap,lMapBlocks * sizeof(long long)) == 0))
+    {
+        for(i = 0, j = 0; i < lMapBlocks; i++)
+        {
+            if(Source[i] != HOLEBLOCK)
+            {
+                inode->BlockMap[i] = lFirst + j;
+                FreeBlock(Source[i]);
+                j++;
+            }
+        }
+
+        Pool.DefragFiles++;
+        Pool.DefragBlocks = Pool.DefragBlocks + lCount;
+        bMoved = true;
+    }
+    else
+    {
+        // File is written or truncated meanwhile, copy is stale
+        for(j = 0; j < lCount; j++)
+        {
+            FreeBlock(lFirst + j);
+        }
+
+        Pool.DefragRetries++;
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    free(Source);
+
+    return bMoved;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DefragmentStep
+//  Description :       It is used to move most fragmented small
+//                      file into one extent
+//  Input :             Nothing
+//  Output :            true if some file is moved
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool DefragmentStep()
+{
+    PINODE temp = NULL;
+    PINODE best = NULL;
+    long long lExtents = 0;
+    long long lBest = 1;
+
+    LockFileSystem(false);
+
+    for(temp = head; temp != NULL; temp = NextInode(temp))
+    {
+        if(CanDefragment(temp) == false)
+        {
+            continue;
+        }
+
+        lExtents = CountExtents(temp);
+
+        if(lExtents > lBest)
+        {
+            best = temp;
+            lBest = lExtents;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    if(best == NULL)
+    {
+        return false;
+    }
+
+    return RelocateFile(best);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DefragThread
+//  Description :       It is used to defragment files in
+//                      background, few files at a time
+//  Input :             Not used
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * DefragThread(
+                        void *arg   // Not used
+                   )
+{
+    int i = 0;
+
+    (void)arg;
+
+    while(1)
+    {
+        usleep(DEFRAGINTERVAL * 1000);
+
+        for(i = 0; (i < DEFRAGBATCH) && (Pool.DefragEnabled == true); i++)
+        {
+            if(DefragmentStep() == false)
+            {
+                break;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ScrubThread
+//  Description :       It is the entry point of scrub thread.
+//                      It walks all blocks of all files again and
+//                      again and verifies their checksums.
+//                      Lock is held for one block at a time so
+//                      that shell is never blocked for long.
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * ScrubThread(
+                        void *arg   // Not used
+                  )
+{
+    PINODE temp = NULL;
+    long long iBlock = 0;
+    int iRate = 0;
+
+    (void)arg;
+
+    while(1)
+    {
+        iRate = __atomic_load_n(&superobj.ScrubRate,__ATOMIC_RELAXED);
+
+        if(iRate <= 0)
+        {
+            usleep(100000);
+            continue;
+        }
+
+        LockFileSystem(false);
+
+        // Pass starts from head, which is set when DILB is extended
+        if(temp == NULL)
+        {
+            temp = head;
+            iBlock = 0;
+        }
+
+        if(temp == NULL)
+        {
+            pthread_rwlock_unlock(&FileSystemLock);
+
+            usleep(1000000 / iRate);
+            continue;
+        }
+
+        // File may be deleted or shrinked since the last block
+        if((temp->FileType != REGULARFILE) || (ColdInode(temp)->Spilled == true) || (iBlock >= BlockCount(temp)))
+        {
+            // Last inode changes when DILB is extended
+            temp = NextInode(temp);
+            iBlock = 0;
+
+            pthread_rwlock_unlock(&FileSystemLock);
+
+            // One pass is over, take a breath before the next one
+            if(temp == NULL)
+            {
+                __atomic_add_fetch(&superobj.ScrubPasses,1,__ATOMIC_RELAXED);
+                usleep(1000000 / iRate);
+            }
+
+            continue;
+        }
+
+        // Holes have no data to verify
+        while((iBlock < BlockCount(temp)) && (temp->BlockMap[iBlock] == HOLEBLOCK))
+        {
+            iBlock++;
+        }
+
+        if(iBlock >= BlockCount(temp))
+        {
+            pthread_rwlock_unlock(&FileSystemLock);
+            continue;
+        }
+
+        VerifyChecksum(temp,iBlock * BLOCKSIZE,BLOCKSIZE);
+        __atomic_add_fetch(&superobj.ScrubbedBlocks,1,__ATOMIC_RELAXED);
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        iBlock++;
+
+        usleep(1000000 / iRate);
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseTier
+//  Description :       It is used to initialise tier store. Backing
+//                      file is created only when tiering is enabled.
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseTier()
+{
+    Tier.Fd = -1;
+    Tier.Enabled = false;
+    Tier.High = 0;
+    Tier.Low = 0;
+    Tier.Idle = 0;
+    Tier.Clock = 0;
+    Tier.End = 0;
+    Tier.Checksum = NULL;
+    Tier.Capacity = 0;
+    Tier.Free = NULL;
+    Tier.FreeCount = 0;
+    Tier.FreeCapacity = 0;
+    Tier.SpilledFiles = 0;
+    Tier.SpilledBlocks = 0;
+    Tier.Spills = 0;
+    Tier.Faults = 0;
+    Tier.BlocksOut = 0;
+    Tier.BlocksIn = 0;
+    Tier.Retries = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReportProgress
+//  Description :      It is used by long operation to tell how far
+//                      it is. Only background job keeps it.
+//  Input :            Work done and total work, 0 if unknown
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReportProgress(
+                        long long done,     // Items done
+                        long long total     // Items in all
+                    )
+{
+    if(CurrentJob == NULL)
+    {
+        return;
+    }
+
+    __atomic_store_n(&CurrentJob->Done,done,__ATOMIC_RELAXED);
+    __atomic_store_n(&CurrentJob->Total,total,__ATOMIC_RELAXED);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseJobs()
+//  Description :      It is used to initialise queue of background
+//                      jobs. Threads are started when jobs come.
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseJobs()
+{
+    pthread_mutex_init(&Jobs.Lock,NULL);
+    pthread_cond_init(&Jobs.Ready,NULL);
+    pthread_cond_init(&Jobs.Finished,NULL);
+
+    Jobs.Jobs = NULL;
+    Jobs.NextId = 1;
+    Jobs.Threads = 0;
+    Jobs.Idle = 0;
+    Jobs.Completed = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseCheckpoint()
+//  Description :      It is used to initialise dirty list and
+//                      counters of checkpoints
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseCheckpoint()
+{
+    pthread_mutex_init(&Checkpoint.Lock,NULL);
+
+    Checkpoint.Dirty = NULL;
+    Checkpoint.DirtyInodes = 0;
+    Checkpoint.Path = NULL;
+    Checkpoint.Sequence = 0;
+    Checkpoint.Failed = false;
+    Checkpoint.Checkpoints = 0;
+    Checkpoint.Full = 0;
+    Checkpoint.Inodes = 0;
+    Checkpoint.Blocks = 0;
+    Checkpoint.Bytes = 0;
+    Checkpoint.LastInodes = 0;
+    Checkpoint.LastBlocks = 0;
+    Checkpoint.LastBytes = 0;
+    Checkpoint.LastTime = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseIndex
+//  Description :       It is used to initialise empty skip list
+//  Input :             Index
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseIndex(
+                        PORDERINDEX index   // Name or size index
+                    )
+{
+    index->Head = (PINDEXNODE)malloc(sizeof(INDEXNODE) + (INDEXLEVELS - 1) * sizeof(PINDEXNODE));
+
+    memset(index->Head,0,sizeof(INDEXNODE) + (INDEXLEVELS - 1) * sizeof(PINDEXNODE));
+    index->Head->Levels = INDEXLEVELS;
+
+    index->Levels = 1;
+    index->Count = 0;
+    index->Stale = NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseLocks()
+//  Description :       It is used to initialise table of advisory locks
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseLocks()
+{
+    int i = 0;
+
+    pthread_mutex_init(&Locks.Mutex,NULL);
+    pthread_cond_init(&Locks.Released,NULL);
+
+    for(i = 0; i < MAXOPENFILES; i++)
+    {
+        Locks.Waiters[i] = NULL;
+    }
+
+    Locks.Acquired = 0;
+    Locks.Contended = 0;
+    Locks.Refused = 0;
+    Locks.Timeouts = 0;
+    Locks.Deadlocks = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseTrace()
+//  Description :       It is used to initialise trace recorder
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void InitialiseTrace()
+{
+    Trace.Fd = -1;
+    Trace.Buffer = NULL;
+    Trace.Length = 0;
+    Trace.Start = 0;
+    Trace.Records = 0;
+
+    pthread_mutex_init(&Trace.Lock,NULL);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FlushTrace()
+//  Description :       It is used to write collected records to
+//                      trace file. Trace lock must be held.
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FlushTrace()
+{
+    int iDone = 0;
+    int iRet = 0;
+
+    while(iDone < Trace.Length)
+    {
+        iRet = write(Trace.Fd,Trace.Buffer + iDone,Trace.Length - iDone);
+
+        if(iRet <= 0)
+        {
+            break;
+        }
+
+        iDone = iDone + iRet;
+    }
+
+    Trace.Length = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TraceCall()
+//  Description :       It is used to record one call when trace is
+//                      being recorded. Call which is not recorded
+//                      costs one check.
+//  Input :             Kind of call, descriptor, offset, size and
+//                      names used by call or NULL
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void TraceCall(
+                int op,             // TRACE_CREATE and so on
+                int fd,             // Descriptor or -1
+                long long offset,   // Offset of file
+                long long size,     // Size or mode
+                const char *name,   // Name used by call or NULL
+                const char *other   // Second name or NULL
+              )
+{
+    TRACERECORD rec;
+    int iName = 0;
+    int iOther = 0;
+
+    if(Trace.Fd == -1)
+    {
+        return;
+    }
+
+    rec.Time = NanoTime();
+    rec.Offset = offset;
+    rec.Size = size;
+    rec.Fd = fd;
+    rec.Op = op;
+
+    iName = (name != NULL) ? strnlen(name,MAXNAMELENGTH) : 0;
+    iOther = (other != NULL) ? strnlen(other,MAXNAMELENGTH) : 0;
+
+    rec.NameLength = (other != NULL) ? iName + 1 + iOther : iName;
+
+    pthread_mutex_lock(&Trace.Lock);
+
+    // Recording may have stopped meanwhile
+    if(Trace.Fd == -1)
+    {
+        pthread_mutex_unlock(&Trace.Lock);
+        return;
+    }
+
+    rec.Time = rec.Time - Trace.Start;
+
+    if(Trace.Length + (int)sizeof(TRACERECORD) + rec.NameLength > TRACEBUFFER)
+    {
+        FlushTrace();
+    }
+
+    memcpy(Trace.Buffer + Trace.Length,&rec,sizeof(TRACERECORD));
+    Trace.Length = Trace.Length + sizeof(TRACERECORD);
+
+    if(name != NULL)
+    {
+        memcpy(Trace.Buffer + Trace.Length,name,iName);
+        Trace.Length = Trace.Length + iName;
+    }
+
+    if(other != NULL)
+    {
+        Trace.Buffer[Trace.Length] = '\0';
+        memcpy(Trace.Buffer + Trace.Length + 1,other,iOther);
+        Trace.Length = Trace.Length + 1 + iOther;
+    }
+
+    Trace.Records++;
+
+    pthread_mutex_unlock(&Trace.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StartTrace()
+//  Description :       It is used to start recording calls into
+//                      trace file of host file system
+//  Input :             Name of trace file
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int StartTrace(
+                const char *path    // Trace file of host
+              )
+{
+    int fd = 0;
+
+    if(path == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&Trace.Lock);
+
+    if(Trace.Fd != -1)
+    {
+        pthread_mutex_unlock(&Trace.Lock);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    fd = open(path,O_WRONLY | O_CREAT | O_TRUNC,0644);
+
+    if(fd == -1)
+    {
+        pthread_mutex_unlock(&Trace.Lock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    Trace.Buffer = (char *)malloc(TRACEBUFFER);
+    memcpy(Trace.Buffer,TRACEMAGIC,TRACEMAGICSIZE);
+    Trace.Length = TRACEMAGICSIZE;
+    Trace.Records = 0;
+    Trace.Start = NanoTime();
+    Trace.Fd = fd;
+
+    pthread_mutex_unlock(&Trace.Lock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StopTrace()
+//  Description :       It is used to stop recording and to close
+//                      trace file
+//  Input :             Nothing
+//  Output :            Number of recorded calls or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long StopTrace()
+{
+    pthread_mutex_lock(&Trace.Lock);
+
+    if(Trace.Fd == -1)
+    {
+        pthread_mutex_unlock(&Trace.Lock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    FlushTrace();
+    close(Trace.Fd);
+
+    free(Trace.Buffer);
+    Trace.Buffer = NULL;
+    Trace.Fd = -1;
+
+    pthread_mutex_unlock(&Trace.Lock);
+
+    return Trace.Records;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StartAuxillaryDataInitilisation
+//  Description :       It is used to call all such functions which are
+//                      used to initialise auxillary data
+//  Input :             Name of image or NULL and cache budget in MB
+//  Author :            Shravani Kishor Darandale
+//  Date :              13/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void StartAuxillaryDataInitilisation(
+                                        const char *image,  // Name of image or NULL
+                                        int megabytes       // Budget of page cache
+                                    )
+{
+    strcpy(bootobj.Information,"Booting process of Marvellous CVFS is done");
+
+    printf("%s\n",bootobj.Information);
+
+    InitialiseSuperBlock();
+
+    CreateDILB();
+
+    InitialiseQuota(&SessionQuota,"Session");
+    InitialiseQuota(&DirectoryQuota,"Directory /");
+
+    InitialiseUAREA();
+
+    InitialiseCRC32C();
+
+    InitialiseSearch();
+
+    InitialiseBlockPool();
+
+    InitialisePageCache(image,megabytes);
+
+    InitialiseTier();
+
+    InitialiseTrace();
+
+    InitialiseEvents();
+
+    InitialiseLocks();
+
+    InitialiseJobs();
+
+    InitialiseCheckpoint();
+
+    InitialiseIndex(&NameIndex);
+    InitialiseIndex(&SizeIndex);
+
+    pthread_create(&ScrubThreadId,NULL,ScrubThread,NULL);
+    pthread_detach(ScrubThreadId);
+
+    pthread_create(&DefragThreadId,NULL,DefragThread,NULL);
+    pthread_detach(DefragThreadId);
+
+    printf("Marvellous CVFS : Auxillary data initialised succesfully\n");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayHelp
+//  Description :       It is used to display the help page
+//  Author :            Shravani Kishor Darandale
+//  Date :              14/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayHelp()
+{
+    printf("-----------------------------------------------\n");
+    printf("---------- Marvellous CVFS Help Page ----------\n");
+    printf("-----------------------------------------------\n");
+
+    printf("ls     : It is used to list files by name, size or inode\n");
+    printf("man    : It is used to display manual page\n");
+    printf("clear  : It is used to clear the terminal\n");
+    printf("creat  : It is used to create new file or many numbered files\n");
+    printf("write  : It is used to write the data into file\n");
+    printf("read   : It is used to read the data from the file\n");
+    printf("stat   : It is used to display statistical information\n");
+    printf("open   : It is used to open the existing file\n");
+    printf("close  : It is used to close the opened file\n");
+    printf("mmap   : It is used to map opened file into memory\n");
+    printf("mwrite : It is used to change data in mapped view\n");
+    printf("msync  : It is used to write changes of mapped view to file\n");
+    printf("munmap : It is used to sync and remove mapped view\n");
+    printf("flock  : It is used to lock whole opened file\n");
+    printf("lock   : It is used to lock bytes of opened file\n");
+    printf("lockstat : It is used to display contention of file locks\n");
+    printf("trace  : It is used to record calls into trace file\n");
+    printf("replay : It is used to execute calls of trace file again\n");
+    printf("unlink : It is used to delete the file or many files\n");
+    printf("append : It is used to add data at end of file\n");
+    printf("begin  : It is used to start batch of creat, append and unlink\n");
+    printf("commit : It is used to apply started batch as a unit\n");
+    printf("abort  : It is used to discard started batch\n");
+    printf("link   : It is used to create new name for existing file\n");
+    printf("rename : It is used to change the name of file\n");
+    printf("cp     : It is used to copy file without copying its data\n");
+    printf("ingest : It is used to copy host directory tree into CVFS\n");
+    printf("lseek  : It is used to change offset of opened file\n");
+    printf("truncate : It is used to change size of file\n");
+    printf("mkfifo : It is used to create FIFO file\n");
+    printf("quota  : It is used to limit memory of session or directory\n");
+    printf("grep   : It is used to search the data in all files\n");
+    printf("scrub  : It is used to set the speed of checksum scrubbing\n");
+    printf("hugepage : It is used to select huge page backing of large files\n");
+    printf("benchmark : It is used to measure scans with and without huge pages\n");
+    printf("cache  : It is used to set memory budget of page cache of image\n");
+    printf("sync   : It is used to write dirty cached blocks to image\n");
+    printf("checkpoint : It is used to write changed files to checkpoint file\n");
+    printf("restore : It is used to load file system from checkpoint file\n");
+    printf("defrag : It is used to make files contiguous in block pool\n");
+    printf("tier   : It is used to spill cold files to backing file\n");
+    printf("jobs   : It is used to display background jobs\n");
+    printf("events : It is used to record trace points and dump them as Chrome trace\n");
+    printf("wait   : It is used to wait for background jobs\n");
+    printf("exit   : It is used to terminate Marvellous CVFS\n");
+
+    printf("-----------------------------------------------\n");
+
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ManPageDisplay
+//  Description :       It is used to display man page
+//  Author :            Shravani Kishor Darandale
+//  Date :              14/01/2026
+//
+//////////////////////////////////////////////////////////
+
+void ManPageDisplay(char Name[])
+{
+    if(strcmp("ls",Name) == 0)
+    {
+        printf("About : It is used to list the names of all files\n");
+        printf("Usage : ls [order] [count]\n");
+        printf("        ls next\n");
+        printf("Order is name, size or inode, name is used when it is not given\n");
+        printf("With count only that many files are listed, ls next lists more\n");
+        printf("Files created or removed during listing do not stop it\n");
+    }
+    else if(strcmp("man",Name) == 0)
+    {
+        printf("About : It is used to display manual page\n");
+        printf("Usage : man command_name\n");
+        printf("command_name : It is the name of command\n");        
+    }
+    else if(strcmp("exit",Name) == 0)
+    {
+        printf("About : It is used to terminate the shell\n");
+        printf("Usage : exit\n");        
+    }
+    else if(strcmp("clear",Name) == 0)
+    {
+        printf("About : It is used to clear the shell\n");
+        printf("Usage : clear\n");        
+    }
+    else if(strcmp("creat",Name) == 0)
+    {
+        printf("About : It is used to create new file\n");
+        printf("Usage : creat file_name permission\n");
+        printf("        creat pattern first..last permission\n");
+        printf("permission : 1 -> READ, 2 -> WRITE, 3 -> READ + WRITE\n");
+        printf("pattern : Name with one %%d such as file_%%d or file_%%06d\n");
+        printf("Bulk form creates all files in one pass without opening them\n");
+        printf("Names which are present already are skipped\n");
+    }
+    else if(strcmp("ingest",Name) == 0)
+    {
+        printf("About : It is used to copy host directory tree into CVFS\n");
+        printf("Usage : ingest Host_directory\n");
+        printf("Name of each file is its path below host directory, as a/b.txt\n");
+        printf("Files are read by many threads and inserted in batches\n");
+        printf("Names which are present already are skipped\n");
+    }
+    else if(strcmp("open",Name) == 0)
+    {
+        printf("About : It is used to open the existing file\n");
+        printf("Usage : open file_name mode\n");
+        printf("mode : 1 -> READ, 2 -> WRITE, 3 -> READ + WRITE\n");
+        printf("       Add 8 for APPEND, every write then goes to end of file\n");
+        printf("       Add 16 for NONBLOCK, full or empty FIFO then fails at once\n");
+    }
+    else if(strcmp("close",Name) == 0)
+    {
+        printf("About : It is used to close the opened file\n");
+        printf("Usage : close file_descriptor\n");
+    }
+    else if(strcmp("mmap",Name) == 0)
+    {
+        printf("About : It is used to map opened file into memory\n");
+        printf("Usage : mmap file_descriptor [offset length]\n");
+        printf("offset : Multiple of %d, length : Bytes of view, 0 for rest of file\n",BLOCKSIZE);
+        printf("View of descriptor without WRITE is read only\n");
+        printf("Changed blocks of view are written by msync, munmap and close\n");
+    }
+    else if(strcmp("mwrite",Name) == 0)
+    {
+        printf("About : It is used to change data in mapped view\n");
+        printf("Usage : mwrite file_descriptor offset_in_view\n");
+        printf("Data reaches file on msync, munmap or close\n");
+    }
+    else if(strcmp("msync",Name) == 0)
+    {
+        printf("About : It is used to write changes of mapped view to file\n");
+        printf("Usage : msync file_descriptor\n");
+        printf("Readers see all changes of one msync at once\n");
+    }
+    else if(strcmp("munmap",Name) == 0)
+    {
+        printf("About : It is used to sync and remove mapped view\n");
+        printf("Usage : munmap file_descriptor\n");
+    }
+    else if(strcmp("trace",Name) == 0)
+    {
+        printf("About : It is used to record calls into trace file\n");
+        printf("Usage : trace file_name|off\n");
+        printf("file_name : File of host which receives binary trace\n");
+        printf("Call, descriptor, offset, size, names and time of each call are kept, not data\n");
+        printf("Ingested files, committed batches and runs of mapped view written by sync are kept too\n");
+    }
+    else if(strcmp("replay",Name) == 0)
+    {
+        printf("About : It is used to execute calls of trace file again\n");
+        printf("Usage : replay file_name [timed]\n");
+        printf("Calls run as fast as possible, or at recorded time with timed\n");
+        printf("File system must be empty, start new shell to replay\n");
+        printf("Throughput and latency of each kind of call are shown\n");
+    }
+    else if(strcmp("unlink",Name) == 0)
+    {
+        printf("About : It is used to delete the name of file\n");
+        printf("Usage : unlink file_name\n");
+        printf("        unlink pattern first..last\n");
+        printf("        unlink shell_pattern\n");
+        printf("pattern : Name with one %%d such as file_%%d\n");
+        printf("shell_pattern : Name with * ? or [ ] such as file_*, all matching names go\n");
+        printf("Data is deleted when last name and last descriptor are gone\n");
+    }
+    else if(strcmp("link",Name) == 0)
+    {
+        printf("About : It is used to create new name for existing file\n");
+        printf("Usage : link existing_name new_name\n");
+    }
+    else if(strcmp("rename",Name) == 0)
+    {
+        printf("About : It is used to change the name of file\n");
+        printf("Usage : rename old_name new_name\n");
+        printf("Existing file with new_name is replaced\n");
+    }
+    else if(strcmp("mkfifo",Name) == 0)
+    {
+        printf("About : It is used to create FIFO file\n");
+        printf("Usage : mkfifo file_name\n");
+        printf("Data written to FIFO waits in ring of %d bytes till it is read\n",FIFOSIZE);
+        printf("Writer waits when ring is full, reader waits when it is empty\n");
+        printf("Open with NONBLOCK (16) to fail instead of waiting\n");
+    }
+    else if(strcmp("quota",Name) == 0)
+    {
+        printf("About : It is used to limit memory used by files\n");
+        printf("Usage : quota session|root bytes inodes\n");
+        printf("session : Files created by this shell, root : All files of root directory\n");
+        printf("bytes : Data blocks and FIFO rings, inodes : Files, 0 means no limit\n");
+        printf("Usage is shown by stat\n");
+    }
+    else if(strcmp("truncate",Name) == 0)
+    {
+        printf("About : It is used to change size of file\n");
+        printf("Usage : truncate file_name size\n");
+        printf("Blocks after new size are freed, growing adds a hole\n");
+    }
+    else if(strcmp("lseek",Name) == 0)
+    {
+        printf("About : It is used to change offset of opened file\n");
+        printf("Usage : lseek file_descriptor offset from\n");
+        printf("from : 0 -> START, 1 -> CURRENT, 2 -> END\n");
+        printf("       3 -> Next data at or after offset, 4 -> Next hole at or after offset\n");
+        printf("Writing past end of file leaves a hole which takes no space\n");
+    }
+    else if(strcmp("grep",Name) == 0)
+    {
+        printf("About : It is used to search the data in all files\n");
+        printf("Usage : grep pattern\n");
+        printf("pattern : Data that we want to search\n");
+    }
+    else if(strcmp("stat",Name) == 0)
+    {
+        printf("About : It is used to display statistical information\n");
+        printf("Usage : stat\n");
+        printf("Shows usage of session and directory quotas too\n");
+    }
+    else if(strcmp("hugepage",Name) == 0)
+    {
+        printf("About : It is used to select backing of large files\n");
+        printf("Usage : hugepage off|transparent|explicit\n");
+        printf("explicit : Uses hugetlbfs pages reserved by OS, else transparent\n");
+    }
+    else if(strcmp("benchmark",Name) == 0)
+    {
+        printf("About : It is used to measure scans with and without huge pages\n");
+        printf("Usage : benchmark size_in_MB\n");
+    }
+    else if(strcmp("cache",Name) == 0)
+    {
+        printf("About : It is used to set memory budget of page cache of image\n");
+        printf("Usage : cache size_in_MB\n");
+        printf("Image is given at start : Marvellous CVFS image_file [cache_MB]\n");
+    }
+    else if(strcmp("sync",Name) == 0)
+    {
+        printf("About : It is used to write dirty cached blocks to image\n");
+        printf("Usage : sync\n");
+        printf("Once checkpoint is written, changes since then are added to its file too\n");
+    }
+    else if(strcmp("checkpoint",Name) == 0)
+    {
+        printf("About : It is used to write changed files to checkpoint file of host\n");
+        printf("Usage : checkpoint Host_file [MB_per_sec]\n");
+        printf("First checkpoint into a file writes all files, later ones append only\n");
+        printf("names, sizes and blocks changed since the previous checkpoint\n");
+        printf("MB_per_sec : Limits speed of writing, use checkpoint file 50 & to keep shell free\n");
+    }
+    else if(strcmp("restore",Name) == 0)
+    {
+        printf("About : It is used to load checkpoints of host file into empty file system\n");
+        printf("Usage : restore Host_file\n");
+        printf("Checkpoints are applied in order, incomplete or damaged tail is cut off\n");
+        printf("FIFO files and files without names are not kept by checkpoints\n");
+    }
+    else if(strcmp("defrag",Name) == 0)
+    {
+        printf("About : It is used to make small files contiguous in block pool\n");
+        printf("Usage : defrag [on|off]\n");
+        printf("Without option all fragmented files are moved now\n");
+        printf("on|off : Starts or stops background defragmenter\n");
+        printf("Fragmentation is shown by stat\n");
+    }
+    else if(strcmp("append",Name) == 0)
+    {
+        printf("About : It is used to add data at end of file\n");
+        printf("Usage : append File_name\n");
+        printf("Data is asked on next line, inside batch it is staged\n");
+    }
+    else if((strcmp("begin",Name) == 0) || (strcmp("commit",Name) == 0) || (strcmp("abort",Name) == 0))
+    {
+        printf("About : It is used to apply many operations as a unit\n");
+        printf("Usage : begin, then creat, append and unlink, then commit or abort\n");
+        printf("Names are checked when staged and again by commit\n");
+        printf("Staged operations are applied in order by commit\n");
+        printf("If one of them fails, none of them is applied\n");
+        printf("When checkpoint file is in use, commit appends checkpoint to it,\n");
+        printf("restore after crash finds either whole batch or none of it\n");
+        printf("Without checkpoint file batch is atomic only in memory\n");
+        printf("abort discards staged operations\n");
+    }
+    else if(strcmp("jobs",Name) == 0)
+    {
+        printf("About : It is used to display background jobs\n");
+        printf("Usage : jobs\n");
+        printf("Command followed by & runs in background, as grep Marvellous &\n");
+        printf("Jobs run on pool of threads, one per CPU, so they overlap\n");
+        printf("Commands which read data from terminal can not run in background\n");
+        printf("Finished jobs are reported before next prompt\n");
+    }
+    else if(strcmp("wait",Name) == 0)
+    {
+        printf("About : It is used to wait for background jobs\n");
+        printf("Usage : wait [Job_Id]\n");
+        printf("Without id it waits till all jobs are done\n");
+    }
+    else if(strcmp("flock",Name) == 0)
+    {
+        printf("About : It is used to lock whole opened file\n");
+        printf("Usage : flock File_Descriptor Mode\n");
+        printf("Mode is sh (shared), ex (exclusive) or un (unlock)\n");
+        printf("Mode/ms waits at most ms milliseconds, mode/0 does not wait\n");
+        printf("Locks are advisory, read and write do not check them\n");
+        printf("Wait which would deadlock fails at once\n");
+    }
+    else if(strcmp("lock",Name) == 0)
+    {
+        printf("About : It is used to lock bytes of opened file\n");
+        printf("Usage : lock File_Descriptor Mode Offset Length\n");
+        printf("Mode is as of flock, length 0 locks till end of file\n");
+        printf("New lock replaces own locks on same bytes, un cuts them\n");
+        printf("All locks of descriptor are dropped when it is closed\n");
+    }
+    else if(strcmp("events",Name) == 0)
+    {
+        printf("About : It is used to record trace points of internals and dump them\n");
+        printf("Usage : events [on|off|clear]\n");
+        printf("        events dump Host_file\n");
+        printf("Each thread keeps its latest %d events, such as lookups, allocation,\n",EVENTSLOTS);
+        printf("copies and waits for lock, inside creat, open, read, write and others\n");
+        printf("Dump file is Chrome trace JSON for chrome://tracing or ui.perfetto.dev\n");
+        printf("Build with -DCVFS_NO_EVENTS removes trace points from code\n");
+    }
+    else if(strcmp("lockstat",Name) == 0)
+    {
+        printf("About : It is used to display contention of file locks\n");
+        printf("Usage : lockstat\n");
+        printf("Files are listed by time spent waiting for their locks\n");
+    }
+    else if(strcmp("cp",Name) == 0)
+    {
+        printf("About : It is used to copy file without copying its data\n");
+        printf("Usage : cp Old_name New_name\n");
+        printf("Both files share data blocks, block is copied when one of them writes it\n");
+    }
+    else if(strcmp("tier",Name) == 0)
+    {
+        printf("About : It is used to spill cold files to backing file\n");
+        printf("Usage : tier high_MB low_MB idle_seconds | tier off\n");
+        printf("When data in memory is above high_MB, files not used for idle_seconds\n");
+        printf("are moved to backing file, coldest first, until it is at low_MB\n");
+        printf("Spilled file comes back to memory when it is read or written\n");
+        printf("Opened files are never spilled, counters are shown by stat\n");
+    }
+    else if(strcmp("scrub",Name) == 0)
+    {
+        printf("About : It is used to set the speed of checksum scrubbing\n");
+        printf("Usage : scrub blocks_per_second\n");
+        printf("blocks_per_second : 0 pauses the scrubbing\n");
+    }
+    else
+    {
+        printf("No manual entry for %s\n",Name);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     HashName
+//  Description :       It is used to calculate hash of file name
+//                      (FNV-1a)
+//  Input :             File name
+//  Output :            Hash of name
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+unsigned int HashName(
+                        const char *name    // File name
+                     )
+{
+    unsigned int iHash = 2166136261u;
+
+    while(*name != '\0')
+    {
+        iHash = (iHash ^ (unsigned char)*name) * 16777619u;
+        name++;
+    }
+
+    return iHash;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IsValidName
+//  Description :       It is used to check length of new file name
+//  Input :             File name
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool IsValidName(
+                    const char *name    // File name
+                )
+{
+    return (name != NULL) && (name[0] != '\0') && (strlen(name) <= MAXNAMELENGTH);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     NameClass
+//  Description :       It is used to calculate size class of name
+//                      in name arena
+//  Input :             Length of name
+//  Output :            Size of name in units of NAMEALIGN
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int NameClass(
+                int length      // Length of name
+             )
+{
+    return (offsetof(NAME,Text) + length + 1 + NAMEALIGN - 1) / NAMEALIGN;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FindName
+//  Description :       It is used to search interned name
+//  Input :             File name and its hash
+//  Output :            Interned name or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PNAME FindName(
+                const char *name,       // File name
+                unsigned int hash       // Hash of name
+              )
+{
+    PNAME temp = Names.Hash[hash % DIRHASHSIZE];
+
+    while(temp != NULL)
+    {
+        if((temp->Hash == hash) && (strcmp(name,temp->Text) == 0))
+        {
+            break;
+        }
+        temp = temp->next;
+    }
+
+    return temp;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InternName
+//  Description :       It is used to take one reference of name.
+//                      Name is copied into name arena only if it
+//                      is not interned already.
+//  Input :             File name
+//  Output :            Interned name
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PNAME InternName(
+                    const char *name    // File name
+                )
+{
+    unsigned int iHash = HashName(name);
+    int iClass = 0;
+    PNAME newn = FindName(name,iHash);
+
+    if(newn != NULL)
+    {
+        newn->References++;
+        return newn;
+    }
+
+    iClass = NameClass(strlen(name));
+
+    if(Names.FreeNames[iClass] != NULL)
+    {
+        newn = Names.FreeNames[iClass];
+        Names.FreeNames[iClass] = newn->next;
+    }
+    else
+    {
+        if((Names.Chunk == NULL) || (Names.ChunkUsed + iClass * NAMEALIGN > NAMECHUNK))
+        {
+            // Tail of old chunk is left unused
+            Names.Chunk = (char *)malloc(NAMECHUNK);
+            Names.ChunkUsed = 0;
+            Names.Chunks++;
+        }
+
+        newn = (PNAME)(Names.Chunk + Names.ChunkUsed);
+        Names.ChunkUsed = Names.ChunkUsed + iClass * NAMEALIGN;
+    }
+
+    strcpy(newn->Text,name);
+    newn->Hash = iHash;
+    newn->References = 1;
+    newn->next = Names.Hash[iHash % DIRHASHSIZE];
+
+    Names.Hash[iHash % DIRHASHSIZE] = newn;
+    Names.Names++;
+    Names.Bytes = Names.Bytes + iClass * NAMEALIGN;
+
+    return newn;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseName
+//  Description :       It is used to drop one reference of name.
+//                      Memory of last reference goes to free list
+//                      of its size class.
+//  Input :             Interned name
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseName(
+                    PNAME name      // Interned name
+                )
+{
+    PNAME *pprev = &Names.Hash[name->Hash % DIRHASHSIZE];
+    int iClass = 0;
+
+    name->References--;
+
+    if(name->References > 0)
+    {
+        return;
+    }
+
+    while(*pprev != name)
+    {
+        pprev = &(*pprev)->next;
+    }
+
+    *pprev = name->next;
+
+    iClass = NameClass(strlen(name->Text));
+
+    name->next = Names.FreeNames[iClass];
+    Names.FreeNames[iClass] = name;
+    Names.Names--;
+    Names.Bytes = Names.Bytes - iClass * NAMEALIGN;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LookupDirEntry
+//  Description :       It is used to search directory entry by
+//                      name. Name which is not interned can not
+//                      be in directory, else entries are matched
+//                      by address of interned name.
+//  Input :             File name
+//  Output :            Directory entry or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PDIRENTRY LookupDirEntry(
+                            const char *name    // File name
+                        )
+{
+    EVENT_SCOPE(EV_LOOKUP,0);
+    PNAME key = FindName(name,HashName(name));
+    PDIRENTRY temp = NULL;
+
+    if(key == NULL)
+    {
+        return NULL;
+    }
+
+    temp = DirectoryHash[key->Hash % DIRHASHSIZE];
+
+    while((temp != NULL) && (temp->FileName != key))
+    {
+        temp = temp->next;
+    }
+
+    return temp;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CompareIndexKey
+//  Description :       It is used to compare key of index node with
+//                      given key. Name is NULL in size index.
+//  Input :             Node and key
+//  Output :            Negative, zero or positive
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CompareIndexKey(
+                        PINDEXNODE node,    // Node of index
+                        long long value,    // Size of file
+                        int number,         // Inode number
+                        const char *name    // File name or NULL
+                    )
+{
+    int iRet = 0;
+
+    if(node->Value != value)
+    {
+        return (node->Value < value) ? -1 : 1;
+    }
+
+    if(name != NULL)
+    {
+        iRet = strcmp(node->Name->Text,name);
+
+        if(iRet != 0)
+        {
+            return iRet;
+        }
+    }
+
+    return node->Number - number;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     InsertIndex
+//  Description :       It is used to insert file into skip list.
+//                      Lock must be held for write.
+//  Input :             Index, key and file
+//  Output :            New node
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINDEXNODE InsertIndex(
+                        PORDERINDEX index,  // Name or size index
+                        long long value,    // Size of file
+                        int number,         // Inode number
+                        PNAME name,         // File name or NULL
+                        void *item          // Directory entry or inode
+                      )
+{
+    PINDEXNODE update[INDEXLEVELS];
+    PINDEXNODE temp = index->Head;
+    PINDEXNODE newn = NULL;
+    int iLevels = 1;
+    int i = 0;
+
+    for(i = index->Levels - 1; i >= 0; i--)
+    {
+        while((temp->next[i] != NULL) && (CompareIndexKey(temp->next[i],value,number,(name != NULL) ? name->Text : NULL) < 0))
+        {
+            temp = temp->next[i];
+        }
+        update[i] = temp;
+    }
+
+    // Each level holds one fourth of level below it
+    IndexSeed ^= IndexSeed << 13;
+    IndexSeed ^= IndexSeed >> 17;
+    IndexSeed ^= IndexSeed << 5;
+
+    while((iLevels < INDEXLEVELS) && (((IndexSeed >> (2 * iLevels)) & 3) == 0))
+    {
+        iLevels++;
+    }
+
+    for(i = index->Levels; i < iLevels; i++)
+    {
+        update[i] = index->Head;
+    }
+
+    if(iLevels > index->Levels)
+    {
+        index->Levels = iLevels;
+    }
+
+    newn = (PINDEXNODE)malloc(sizeof(INDEXNODE) + (iLevels - 1) * sizeof(PINDEXNODE));
+
+    newn->Value = value;
+    newn->Number = number;
+    newn->Name = name;
+    newn->Item = item;
+    newn->Levels = iLevels;
+
+    for(i = 0; i < iLevels; i++)
+    {
+        newn->next[i] = update[i]->next[i];
+        update[i]->next[i] = newn;
+    }
+
+    index->Count++;
+
+    return newn;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RemoveIndex
+//  Description :       It is used to remove node from skip list
+//                      and free it. Lock must be held for write.
+//  Input :             Index and node
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void RemoveIndex(
+                    PORDERINDEX index,  // Name or size index
+                    PINDEXNODE node     // Node to remove
+                 )
+{
+    PINDEXNODE temp = index->Head;
+    const char *name = (node->Name != NULL) ? node->Name->Text : NULL;
+    int i = 0;
+
+    for(i = index->Levels - 1; i >= 0; i--)
+    {
+        while((temp->next[i] != NULL) && (CompareIndexKey(temp->next[i],node->Value,node->Number,name) < 0))
+        {
+            temp = temp->next[i];
+        }
+
+        if(temp->next[i] == node)
+        {
+            temp->next[i] = node->next[i];
+        }
+    }
+
+    while((index->Levels > 1) && (index->Head->next[index->Levels - 1] == NULL))
+    {
+        index->Levels--;
+    }
+
+    index->Count--;
+
+    free(node);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SeekIndex
+//  Description :       It is used to find first file of skip list
+//                      after position of listing
+//  Input :             Index and cursor
+//  Output :            Node or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINDEXNODE SeekIndex(
+                        PORDERINDEX index,      // Name or size index
+                        PLISTCURSOR cursor      // Position of listing
+                    )
+{
+    PINDEXNODE temp = index->Head;
+    const char *name = (cursor->Order == LIST_NAME) ? cursor->Name : NULL;
+    int i = 0;
+
+    if(cursor->Started == false)
+    {
+        return temp->next[0];
+    }
+
+    for(i = index->Levels - 1; i >= 0; i--)
+    {
+        while((temp->next[i] != NULL) && (CompareIndexKey(temp->next[i],cursor->Value,cursor->Number,name) <= 0))
+        {
+            temp = temp->next[i];
+        }
+    }
+
+    return temp->next[0];
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MarkCheckpoint
+//  Description :      It is used to put changed inode on dirty
+//                      list of next checkpoint. Lock must be held
+//                      for write.
+//  Input :            Inode
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void MarkCheckpoint(
+                    PINODE inode    // Inode of file
+                   )
+{
+    PINODECOLD cold = ColdInode(inode);
+
+    if(cold->CheckpointDirty == true)
+    {
+        return;
+    }
+
+    cold->CheckpointDirty = true;
+    cold->NextDirty = Checkpoint.Dirty;
+    Checkpoint.Dirty = inode;
+    Checkpoint.DirtyInodes++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MarkBlocksDirty
+//  Description :      It is used to remember blocks written
+//                      since last checkpoint. Bitmap grows by
+//                      doubling. Lock must be held for write.
+//  Input :            Inode, offset and size of written range
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void MarkBlocksDirty(
+                        PINODE inode,       // Inode of file
+                        long long offset,   // Offset of range
+                        long long size      // Size of range
+                    )
+{
+    PINODECOLD cold = ColdInode(inode);
+    long long lLast = 0;
+    long long lNewSize = 0;
+    long long i = 0;
+
+    MarkCheckpoint(inode);
+
+    if((cold->CheckpointAll == true) || (size <= 0))
+    {
+        return;
+    }
+
+    lLast = (offset + size - 1) / BLOCKSIZE;
+
+    if(lLast / 8 >= cold->DirtyBytes)
+    {
+        lNewSize = (cold->DirtyBytes == 0) ? 64 : cold->DirtyBytes;
+
+        while(lLast / 8 >= lNewSize)
+        {
+            lNewSize = lNewSize * 2;
+        }
+
+        cold->DirtyBlocks = (unsigned char *)realloc(cold->DirtyBlocks,lNewSize);
+        memset(cold->DirtyBlocks + cold->DirtyBytes,0,lNewSize - cold->DirtyBytes);
+        cold->DirtyBytes = lNewSize;
+    }
+
+    for(i = offset / BLOCKSIZE; i <= lLast; i++)
+    {
+        cold->DirtyBlocks[i / 8] |= (1 << (i % 8));
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IndexDirEntry
+//  Description :       It is used to add directory entry to name
+//                      index and to names of its inode. Inode
+//                      enters size index with its first name.
+//  Input :             Directory entry
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void IndexDirEntry(
+                    PDIRENTRY entry     // Entry in name hash
+                  )
+{
+    PINODE inode = entry->ptrinode;
+    PINODECOLD cold = ColdInode(inode);
+
+    entry->NameNode = InsertIndex(&NameIndex,0,inode->InodeNumber,entry->FileName,entry);
+
+    entry->nextname = cold->Entries;
+    cold->Entries = entry;
+
+    MarkCheckpoint(inode);
+
+    if(cold->SizeNode == NULL)
+    {
+        cold->SizeNode = InsertIndex(&SizeIndex,inode->ActualFileSize,inode->InodeNumber,NULL,inode);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnindexDirEntry
+//  Description :       It is used to remove directory entry from
+//                      name index and from names of its inode
+//  Input :             Directory entry
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void UnindexDirEntry(
+                        PDIRENTRY entry     // Entry removed from name hash
+                    )
+{
+    PDIRENTRY *pprev = &ColdInode(entry->ptrinode)->Entries;
+
+    RemoveIndex(&NameIndex,entry->NameNode);
+    entry->NameNode = NULL;
+
+    while(*pprev != entry)
+    {
+        pprev = &(*pprev)->nextname;
+    }
+
+    *pprev = entry->nextname;
+    entry->nextname = NULL;
+
+    MarkCheckpoint(entry->ptrinode);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MarkSizeChanged
+//  Description :       It is used to remember that size of file
+//                      changed. Size index is refreshed only when
+//                      it is listed, so writes stay cheap.
+//  Input :             Inode
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void MarkSizeChanged(
+                        PINODE inode    // Inode of file
+                    )
+{
+    PINODECOLD cold = ColdInode(inode);
+
+    // Checkpoint cuts file to its smallest size before its blocks
+    if(inode->ActualFileSize < cold->MinSize)
+    {
+        cold->MinSize = inode->ActualFileSize;
+    }
+
+    MarkCheckpoint(inode);
+
+    if(cold->SizeStale == true)
+    {
+        return;
+    }
+
+    cold->SizeStale = true;
+    cold->NextStale = SizeIndex.Stale;
+    SizeIndex.Stale = inode;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RefreshSizeIndex
+//  Description :       It is used to move files whose size changed
+//                      to their place in size index. Lock must be
+//                      held for write.
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void RefreshSizeIndex()
+{
+    PINODE inode = NULL;
+    PINODECOLD cold = NULL;
+
+    while(SizeIndex.Stale != NULL)
+    {
+        inode = SizeIndex.Stale;
+        cold = ColdInode(inode);
+
+        SizeIndex.Stale = cold->NextStale;
+        cold->NextStale = NULL;
+        cold->SizeStale = false;
+
+        // Freed inode left size index already
+        if((cold->SizeNode == NULL) || (cold->SizeNode->Value == inode->ActualFileSize))
+        {
+            continue;
+        }
+
+        RemoveIndex(&SizeIndex,cold->SizeNode);
+        cold->SizeNode = InsertIndex(&SizeIndex,inode->ActualFileSize,inode->InodeNumber,NULL,inode);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AddDirEntry
+//  Description :       It is used to insert new name of inode
+//                      into directory name index
+//  Input :             File name and inode
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void AddDirEntry(
+                    const char *name,   // File name
+                    PINODE inode        // Inode of file
+                )
+{
+    PDIRENTRY newn = (PDIRENTRY)malloc(sizeof(DIRENTRY));
+    unsigned int iBucket = 0;
+
+    newn->FileName = InternName(name);
+    newn->ptrinode = inode;
+
+    iBucket = newn->FileName->Hash % DIRHASHSIZE;
+    newn->next = DirectoryHash[iBucket];
+
+    DirectoryHash[iBucket] = newn;
+
+    IndexDirEntry(newn);
+
+    inode->LinkCount++;
+    inode->ReferenceCount++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RemoveDirEntry
+//  Description :       It is used to remove name from directory
+//                      name index. Inode and interned name are
+//                      not released here.
+//  Input :             File name
+//  Output :            Removed directory entry or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PDIRENTRY RemoveDirEntry(
+                            const char *name    // File name
+                        )
+{
+    PDIRENTRY *pprev = NULL;
+    PDIRENTRY temp = NULL;
+    PNAME key = FindName(name,HashName(name));
+
+    if(key == NULL)
+    {
+        return NULL;
+    }
+
+    pprev = &DirectoryHash[key->Hash % DIRHASHSIZE];
+
+    while(*pprev != NULL)
+    {
+        temp = *pprev;
+
+        if(temp->FileName == key)
+        {
+            *pprev = temp->next;
+            temp->next = NULL;
+            UnindexDirEntry(temp);
+            return temp;
+        }
+        pprev = &temp->next;
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CreateFifo()
+//  Description :       It is used to allocate empty ring buffer of
+//                      FIFO file
+//  Input :             Nothing
+//  Output :            Address of FIFO
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PFIFO CreateFifo()
+{
+    PFIFO fifo = NULL;
+
+    if(posix_memalign((void **)&fifo,64,sizeof(FIFO)) != 0)
+    {
+        return NULL;
+    }
+
+    fifo->Data = (char *)malloc(FIFOSIZE);
+
+    if(fifo->Data == NULL)
+    {
+        free(fifo);
+        return NULL;
+    }
+
+    fifo->Capacity = FIFOSIZE;
+    fifo->Head = 0;
+    fifo->Tail = 0;
+    fifo->Readers = 0;
+    fifo->Writers = 0;
+    fifo->Waiting = 0;
+
+    pthread_mutex_init(&fifo->WriteLock,NULL);
+    pthread_mutex_init(&fifo->ReadLock,NULL);
+    pthread_mutex_init(&fifo->WaitLock,NULL);
+    pthread_cond_init(&fifo->Wakeup,NULL);
+
+    return fifo;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DeleteFifo()
+//  Description :       It is used to free ring buffer of FIFO
+//  Input :             Address of FIFO
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DeleteFifo(
+                    PFIFO fifo      // Address of FIFO
+               )
+{
+    pthread_mutex_destroy(&fifo->WriteLock);
+    pthread_mutex_destroy(&fifo->ReadLock);
+    pthread_mutex_destroy(&fifo->WaitLock);
+    pthread_cond_destroy(&fifo->Wakeup);
+
+    free(fifo->Data);
+    free(fifo);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FindConflict
+//  Description :       It is used to find lock of other owner which
+//                      overlaps given bytes and does not allow the
+//                      requested mode. Lock mutex must be held.
+//  Input :             Locks of inode, owner, bytes and mode
+//  Output :            Conflicting lock or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PFILELOCK FindConflict(
+                        PLOCKSTATE state,   // Locks of inode
+                        int owner,          // File descriptor
+                        long long start,    // First byte
+                        long long end,      // First byte after range
+                        int type            // LOCK_SHARED or LOCK_EXCLUSIVE
+                      )
+{
+    PFILELOCK temp = NULL;
+
+    for(temp = state->Held; temp != NULL; temp = temp->next)
+    {
+        if((temp->Owner != owner) && (temp->Start < end) && (start < temp->End) &&
+           ((type == LOCK_EXCLUSIVE) || (temp->Type == LOCK_EXCLUSIVE)))
+        {
+            return temp;
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WouldDeadlock
+//  Description :       It is used to check whether owner would wait
+//                      for itself. Owners which hold conflicting locks
+//                      are followed through the locks they sleep for.
+//                      Lock mutex must be held.
+//  Input :             Owner and its request
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool WouldDeadlock(
+                    int owner,          // File descriptor
+                    PINODE inode,       // Inode of request
+                    long long start,    // First byte
+                    long long end,      // First byte after range
+                    int type            // LOCK_SHARED or LOCK_EXCLUSIVE
+                  )
+{
+    bool Visited[MAXOPENFILES] = {false};
+    int Stack[MAXOPENFILES];
+    int iTop = 0;
+    int iOwner = 0;
+    PFILELOCK temp = NULL;
+    PLOCKWAIT wait = NULL;
+    PLOCKSTATE state = NULL;
+
+    Visited[owner] = true;
+    Stack[iTop++] = owner;
+
+    while(iTop > 0)
+    {
+        iOwner = Stack[--iTop];
+
+        if(iOwner == owner)
+        {
+            state = ColdInode(inode)->Locking;
+            wait = NULL;
+        }
+        else
+        {
+            wait = Locks.Waiters[iOwner];
+            state = ColdInode(wait->ptrinode)->Locking;
+        }
+
+        for(temp = state->Held; temp != NULL; temp = temp->next)
+        {
+            if((temp->Owner == iOwner) ||
+               (wait == NULL && ((temp->Start >= end) || (start >= temp->End) || ((type != LOCK_EXCLUSIVE) && (temp->Type != LOCK_EXCLUSIVE)))) ||
+               (wait != NULL && ((temp->Start >= wait->End) || (wait->Start >= temp->End) || ((wait->Type != LOCK_EXCLUSIVE) && (temp->Type != LOCK_EXCLUSIVE)))))
+            {
+                continue;
+            }
+
+            // Holder of conflicting lock waits for requester
+            if(temp->Owner == owner)
+            {
+                return true;
+            }
+
+            if((Visited[temp->Owner] == false) && (Locks.Waiters[temp->Owner] != NULL))
+            {
+                Visited[temp->Owner] = true;
+                Stack[iTop++] = temp->Owner;
+            }
+        }
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseRange
+//  Description :       It is used to drop locks of owner on given
+//                      bytes. Lock which covers more is cut, and
+//                      split if range is in its middle. Lock mutex
+//                      must be held.
+//  Input :             Locks of inode, owner and bytes
+//  Output :            Number of locks changed
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ReleaseRange(
+                    PLOCKSTATE state,   // Locks of inode
+                    int owner,          // File descriptor
+                    long long start,    // First byte
+                    long long end       // First byte after range
+                )
+{
+    PFILELOCK *pprev = &state->Held;
+    PFILELOCK temp = NULL;
+    PFILELOCK newn = NULL;
+    int iChanged = 0;
+
+    while(*pprev != NULL)
+    {
+        temp = *pprev;
+
+        if((temp->Owner != owner) || (temp->End <= start) || (temp->Start >= end))
+        {
+            pprev = &temp->next;
+            continue;
+        }
+
+        iChanged++;
+
+        if((temp->Start < start) && (temp->End > end))
+        {
+            newn = (PFILELOCK)malloc(sizeof(FILELOCK));
+
+            newn->Start = end;
+            newn->End = temp->End;
+            newn->Type = temp->Type;
+            newn->Owner = owner;
+            newn->next = temp->next;
+
+            temp->End = start;
+            temp->next = newn;
+
+            pprev = &newn->next;
+        }
+        else if(temp->Start < start)
+        {
+            temp->End = start;
+            pprev = &temp->next;
+        }
+        else if(temp->End > end)
+        {
+            temp->Start = end;
+            pprev = &temp->next;
+        }
+        else
+        {
+            *pprev = temp->next;
+            free(temp);
+        }
+    }
+
+    return iChanged;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RecordLockWait
+//  Description :       It is used to add one wait for lock to
+//                      counters of inode. Lock mutex must be held.
+//  Input :             Locks of inode and nanoseconds waited
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void RecordLockWait(
+                        PLOCKSTATE state,   // Locks of inode
+                        long long wait      // Nanoseconds
+                    )
+{
+    long long lMicro = wait / 1000;
+    int iBucket = 0;
+
+    while((lMicro >= 10) && (iBucket < LOCKBUCKETS - 1))
+    {
+        lMicro = lMicro / 10;
+        iBucket++;
+    }
+
+    state->Histogram[iBucket]++;
+    state->WaitTime += wait;
+
+    if(wait > state->MaxWait)
+    {
+        state->MaxWait = wait;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LockFile()
+//  Description :       It is used to take, change or drop advisory
+//                      lock on bytes of opened file. Locks of same
+//                      descriptor never conflict, new lock replaces
+//                      its own locks on same bytes. Timeout 0 does
+//                      not wait and LOCK_FOREVER waits till the lock
+//                      is granted.
+//  Input :             Descriptor, first byte, length (0 for
+//                      end of file), mode and timeout in ms
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int LockFile(
+                int fd,             // File descriptor
+                long long start,    // First byte
+                long long length,   // Bytes, 0 till end of file
+                int type,           // LOCK_SHARED, LOCK_EXCLUSIVE or LOCK_RELEASE
+                int timeout         // Milliseconds, 0 or LOCK_FOREVER
+            )
+{
+    PINODE inode = NULL;
+    PINODECOLD cold = NULL;
+    PLOCKSTATE state = NULL;
+    PFILELOCK newn = NULL;
+    LOCKWAIT wait;
+    struct timespec ts;
+    long long lEnd = 0;
+    long long lStart = 0;
+    int iRet = 0;
+
+    if((fd < 0) || (fd >= MAXOPENFILES) || (start < 0) || (length < 0) || (length > LLONG_MAX - start) ||
+       (type < LOCK_RELEASE) || (type > LOCK_EXCLUSIVE) || (timeout < LOCK_FOREVER))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    lEnd = (length == 0) ? LLONG_MAX : start + length;
+
+    LockFileSystem(false);
+
+    if(uareaobj.UFDT[fd] == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    // Descriptor keeps inode alive, close cancels the wait below
+    inode = uareaobj.UFDT[fd]->ptrinode;
+    cold = ColdInode(inode);
+
+    pthread_mutex_lock(&Locks.Mutex);
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    if(cold->Locking == NULL)
+    {
+        cold->Locking = (PLOCKSTATE)calloc(1,sizeof(LOCKSTATE));
+    }
+
+    state = cold->Locking;
+
+    if(type == LOCK_RELEASE)
+    {
+        if(ReleaseRange(state,fd,start,lEnd) > 0)
+        {
+            pthread_cond_broadcast(&Locks.Released);
+        }
+
+        pthread_mutex_unlock(&Locks.Mutex);
+        return EXECUTE_SUCCESS;
+    }
+
+    if(FindConflict(state,fd,start,lEnd,type) != NULL)
+    {
+        state->Contended++;
+        Locks.Contended++;
+
+        if(timeout == 0)
+        {
+            state->Refused++;
+            Locks.Refused++;
+            pthread_mutex_unlock(&Locks.Mutex);
+            return ERR_WOULD_BLOCK;
+        }
+
+        if(WouldDeadlock(fd,inode,start,lEnd,type) == true)
+        {
+            state->Deadlocks++;
+            Locks.Deadlocks++;
+            pthread_mutex_unlock(&Locks.Mutex);
+            return ERR_DEADLOCK;
+        }
+
+        wait.ptrinode = inode;
+        wait.Start = start;
+        wait.End = lEnd;
+        wait.Type = type;
+        wait.Cancelled = false;
+
+        Locks.Waiters[fd] = &wait;
+
+        lStart = NanoTime();
+
+        clock_gettime(CLOCK_REALTIME,&ts);
+        ts.tv_sec += timeout / 1000;
+        ts.tv_nsec += (long)(timeout % 1000) * 1000000;
+
+        if(ts.tv_nsec >= 1000000000)
+        {
+            ts.tv_sec++;
+            ts.tv_nsec = ts.tv_nsec - 1000000000;
+        }
+
+        // Locks of inode may be freed once wait is cancelled
+        while((wait.Cancelled == false) && (FindConflict(state,fd,start,lEnd,type) != NULL) && (iRet != ETIMEDOUT))
+        {
+            if(timeout == LOCK_FOREVER)
+            {
+                pthread_cond_wait(&Locks.Released,&Locks.Mutex);
+            }
+            else
+            {
+                iRet = pthread_cond_timedwait(&Locks.Released,&Locks.Mutex,&ts);
+            }
+        }
+
+        if(Locks.Waiters[fd] == &wait)
+        {
+            Locks.Waiters[fd] = NULL;
+        }
+
+        if(wait.Cancelled == true)
+        {
+            pthread_mutex_unlock(&Locks.Mutex);
+            return ERR_FILE_NOT_EXIST;
+        }
+
+        RecordLockWait(state,NanoTime() - lStart);
+
+        if(FindConflict(state,fd,start,lEnd,type) != NULL)
+        {
+            state->Timeouts++;
+            Locks.Timeouts++;
+            pthread_mutex_unlock(&Locks.Mutex);
+            return ERR_TIMED_OUT;
+        }
+    }
+
+    // Shared lock replacing own exclusive one lets others in
+    if(ReleaseRange(state,fd,start,lEnd) > 0)
+    {
+        pthread_cond_broadcast(&Locks.Released);
+    }
+
+    newn = (PFILELOCK)malloc(sizeof(FILELOCK));
+
+    newn->Start = start;
+    newn->End = lEnd;
+    newn->Type = type;
+    newn->Owner = fd;
+    newn->next = state->Held;
+
+    state->Held = newn;
+
+    state->Acquired++;
+    Locks.Acquired++;
+
+    pthread_mutex_unlock(&Locks.Mutex);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseLocks
+//  Description :       It is used to drop all locks of descriptor
+//                      which is closed and to cancel its wait
+//  Input :             Descriptor and its inode
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseLocks(
+                    int fd,         // File descriptor
+                    PINODE inode    // Inode of descriptor
+                 )
+{
+    pthread_mutex_lock(&Locks.Mutex);
+
+    if(Locks.Waiters[fd] != NULL)
+    {
+        Locks.Waiters[fd]->Cancelled = true;
+        Locks.Waiters[fd] = NULL;
+        pthread_cond_broadcast(&Locks.Released);
+    }
+
+    if((ColdInode(inode)->Locking != NULL) && (ReleaseRange(ColdInode(inode)->Locking,fd,0,LLONG_MAX) > 0))
+    {
+        pthread_cond_broadcast(&Locks.Released);
+    }
+
+    pthread_mutex_unlock(&Locks.Mutex);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseInode
+//  Description :       It is used to drop one reference of inode.
+//                      Data of file is freed when last name and
+//                      last open file table are gone.
+//  Input :             Inode of file
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseInode(
+                    PINODE inode    // Inode of file
+                 )
+{
+    inode->ReferenceCount--;
+
+    if(inode->ReferenceCount > 0)
+    {
+        return;
+    }
+
+    ChargeFile(inode,-(inode->Blocks * BLOCKSIZE + ((ColdInode(inode)->Fifo != NULL) ? FIFOSIZE : 0)),-1);
+
+    //Give data blocks back to pool
+    FreeFileBlocks(inode);
+
+    if(ColdInode(inode)->Fifo != NULL)
+    {
+        DeleteFifo(ColdInode(inode)->Fifo);
+        ColdInode(inode)->Fifo = NULL;
+    }
+
+    // Every descriptor is closed, so no lock is held or awaited
+    if(ColdInode(inode)->Locking != NULL)
+    {
+        pthread_mutex_lock(&Locks.Mutex);
+        free(ColdInode(inode)->Locking);
+        ColdInode(inode)->Locking = NULL;
+        pthread_mutex_unlock(&Locks.Mutex);
+    }
+
+    // Inode may stay in stale list, it is skipped there
+    if(ColdInode(inode)->SizeNode != NULL)
+    {
+        RemoveIndex(&SizeIndex,ColdInode(inode)->SizeNode);
+        ColdInode(inode)->SizeNode = NULL;
+    }
+
+    // Next checkpoint frees it, data of next file starts from nothing
+    free(ColdInode(inode)->DirtyBlocks);
+    ColdInode(inode)->DirtyBlocks = NULL;
+    ColdInode(inode)->DirtyBytes = 0;
+    ColdInode(inode)->CheckpointAll = false;
+    ColdInode(inode)->MinSize = 0;
+    MarkCheckpoint(inode);
+
+    //Reset all values of INODE
+    //Dont deallocate memory of INODE
+    inode->FileSize = 0;
+    inode->ActualFileSize = 0;
+    inode->FileType = 0;
+    inode->LinkCount = 0;
+    inode->Permission = 0;
+
+    superobj.FreeInodes++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IsFileExist
+//  Description :       It is used to check whether file is already exist or not
+//  Input :             It accepts file name
+//  Output :            It returns the true or false
+//  Author :            PShravani Kishor Darandale
+//  Date :              16/01/2026
+//
+//////////////////////////////////////////////////////////
+
+bool IsFileExist(
+                    char *name      // File name
+                )
+{
+    return (LookupDirEntry(name) != NULL);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoWake()
+//  Description :       It is used to wake threads sleeping on FIFO.
+//                      Mutex is touched only when someone sleeps.
+//  Input :             Address of FIFO
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FifoWake(
+                PFIFO fifo      // Address of FIFO
+             )
+{
+    if(__atomic_load_n(&fifo->Waiting,__ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&fifo->WaitLock);
+        pthread_cond_broadcast(&fifo->Wakeup);
+        pthread_mutex_unlock(&fifo->WaitLock);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoWait()
+//  Description :       It is used to sleep till other side moves
+//                      given position. Sleeper is counted before
+//                      position is checked again, so a wake up
+//                      can not be lost. Sleep is also bounded so
+//                      that open and close are noticed.
+//  Input :             Address of FIFO, position and its old value
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FifoWait(
+                PFIFO fifo,                 // Address of FIFO
+                volatile long long *position,   // Head or Tail
+                long long seen              // Value seen by caller
+             )
+{
+    struct timespec ts;
+
+    pthread_mutex_lock(&fifo->WaitLock);
+
+    __atomic_add_fetch(&fifo->Waiting,1,__ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(position,__ATOMIC_SEQ_CST) == seen)
+    {
+        clock_gettime(CLOCK_REALTIME,&ts);
+
+        ts.tv_nsec = ts.tv_nsec + 100000000;
+
+        if(ts.tv_nsec >= 1000000000)
+        {
+            ts.tv_sec++;
+            ts.tv_nsec = ts.tv_nsec - 1000000000;
+        }
+
+        pthread_cond_timedwait(&fifo->Wakeup,&fifo->WaitLock,&ts);
+    }
+
+    __atomic_sub_fetch(&fifo->Waiting,1,__ATOMIC_SEQ_CST);
+
+    pthread_mutex_unlock(&fifo->WaitLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoBegin()
+//  Description :       It is used to get contiguous part of ring
+//                      which can be written (WRITE) or read (READ)
+//                      in place. Side is locked till FifoEnd, so
+//                      writers (or readers) never overlap even if
+//                      one more opens meanwhile. Single writer and
+//                      single reader use different locks and only
+//                      pay an uncontended lock per part.
+//  Input :             File table, READ or WRITE, whether to wait
+//                      Address of pointer and size to fill
+//  Output :            EXECUTE_SUCCESS, ERR_WOULD_BLOCK or
+//                      ERR_BROKEN_PIPE. Size 0 on read is end
+//                      of file, as there is no writer.
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int FifoBegin(
+                PFILETABLE ft,      // File table
+                int mode,           // READ or WRITE
+                bool wait,          // Wait if nothing is possible
+                char **ptr,         // Start of part of ring
+                long long *size     // Size of part of ring
+             )
+{
+    PFIFO fifo = ColdInode(ft->ptrinode)->Fifo;
+    pthread_mutex_t *pLock = (mode == WRITE) ? &fifo->WriteLock : &fifo->ReadLock;
+    long long lHead = 0, lTail = 0, lIndex = 0, lAvail = 0;
+    int iSpin = 0;
+    int iRet = EXECUTE_SUCCESS;
+
+    pthread_mutex_lock(pLock);
+
+    while(1)
+    {
+        lHead = __atomic_load_n(&fifo->Head,__ATOMIC_ACQUIRE);
+        lTail = __atomic_load_n(&fifo->Tail,__ATOMIC_ACQUIRE);
+
+        lIndex = ((mode == WRITE) ? lHead : lTail) & (fifo->Capacity - 1);
+        lAvail = (mode == WRITE) ? (fifo->Capacity - (lHead - lTail)) : (lHead - lTail);
+
+        if(lAvail > 0)
+        {
+            *ptr = fifo->Data + lIndex;
+            *size = (lAvail < fifo->Capacity - lIndex) ? lAvail : (fifo->Capacity - lIndex);
+
+            return EXECUTE_SUCCESS;
+        }
+
+        *ptr = NULL;
+        *size = 0;
+
+        // Nobody can ever change the ring
+        if((mode == WRITE) && (__atomic_load_n(&fifo->Readers,__ATOMIC_ACQUIRE) == 0))
+        {
+            iRet = ERR_BROKEN_PIPE;
+            break;
+        }
+        if((mode == READ) && (__atomic_load_n(&fifo->Writers,__ATOMIC_ACQUIRE) == 0))
+        {
+            iRet = EXECUTE_SUCCESS;
+            break;
+        }
+
+        if(wait == false)
+        {
+            iRet = ERR_WOULD_BLOCK;
+            break;
+        }
+
+        // Other side is usually quick, sleep only when it is not
+        iSpin++;
+
+        if(iSpin > FIFOSPINS)
+        {
+            if(mode == WRITE)
+            {
+                FifoWait(fifo,&fifo->Tail,lTail);
+            }
+            else
+            {
+                FifoWait(fifo,&fifo->Head,lHead);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(pLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoEnd()
+//  Description :       It is used to publish data written in place
+//                      (WRITE) or to free space read in place (READ)
+//                      and to unlock side locked by FifoBegin
+//  Input :             File table, READ or WRITE and size
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FifoEnd(
+                PFILETABLE ft,      // File table
+                int mode,           // READ or WRITE
+                long long size      // Bytes written or read
+            )
+{
+    PFIFO fifo = ColdInode(ft->ptrinode)->Fifo;
+
+    if(mode == WRITE)
+    {
+        __atomic_store_n(&fifo->Head,fifo->Head + size,__ATOMIC_SEQ_CST);
+    }
+    else
+    {
+        __atomic_store_n(&fifo->Tail,fifo->Tail + size,__ATOMIC_SEQ_CST);
+    }
+
+    pthread_mutex_unlock((mode == WRITE) ? &fifo->WriteLock : &fifo->ReadLock);
+
+    FifoWake(fifo);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoWrite()
+//  Description :       It is used to copy data into FIFO. Blocking
+//                      table waits till all data is written, non
+//                      blocking table writes what fits.
+//  Input :             File table, data and its size
+//  Output :            Bytes written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long FifoWrite(
+                        PFILETABLE ft,      // File table
+                        const char *data,   // Data to write
+                        long long size      // Size of data
+                   )
+{
+    long long lDone = 0, lChunk = 0;
+    char *ptr = NULL;
+    int iRet = 0;
+
+    while(lDone < size)
+    {
+        iRet = FifoBegin(ft,WRITE,(ft->Mode & NONBLOCK) == 0,&ptr,&lChunk);
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            return (lDone > 0) ? lDone : iRet;
+        }
+
+        if(lChunk > size - lDone)
+        {
+            lChunk = size - lDone;
+        }
+
+        memcpy(ptr,data + lDone,lChunk);
+        FifoEnd(ft,WRITE,lChunk);
+
+        lDone = lDone + lChunk;
+    }
+
+    return lDone;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FifoRead()
+//  Description :       It is used to copy data out of FIFO. Blocking
+//                      table waits for first byte only, then takes
+//                      whatever is present up to size.
+//  Input :             File table, buffer and its size
+//  Output :            Bytes read, 0 at end of file or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long FifoRead(
+                    PFILETABLE ft,      // File table
+                    char *data,         // Buffer to fill
+                    long long size      // Size of buffer
+                  )
+{
+    long long lDone = 0, lChunk = 0;
+    char *ptr = NULL;
+    int iRet = 0;
+
+    while(lDone < size)
+    {
+        iRet = FifoBegin(ft,READ,((ft->Mode & NONBLOCK) == 0) && (lDone == 0),&ptr,&lChunk);
+
+        if((iRet != EXECUTE_SUCCESS) || (lChunk == 0))
+        {
+            return (lDone > 0) ? lDone : iRet;
+        }
+
+        if(lChunk > size - lDone)
+        {
+            lChunk = size - lDone;
+        }
+
+        memcpy(data + lDone,ptr,lChunk);
+        FifoEnd(ft,READ,lChunk);
+
+        lDone = lDone + lChunk;
+    }
+
+    return lDone;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FreeFileTable()
+//  Description :       It is used to free file table whose last
+//                      reference is gone. Lock must be held for
+//                      write.
+//  Input :             File table
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FreeFileTable(
+                    PFILETABLE ft       // File table
+                  )
+{
+    // File may be already unlinked, then this frees its data
+    ReleaseInode(ft->ptrinode);
+
+    pthread_mutex_destroy(&ft->OffsetLock);
+    free(ft->WriteBuffer);
+    free(ft);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     PutFileTable()
+//  Description :       It is used to drop reference which FIFO call
+//                      took before it left lock. Table closed
+//                      meanwhile is freed by its last user. Lock
+//                      must not be held.
+//  Input :             File table
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void PutFileTable(
+                    PFILETABLE ft       // File table
+                 )
+{
+    if(__atomic_sub_fetch(&ft->References,1,__ATOMIC_ACQ_REL) > 0)
+    {
+        return;
+    }
+
+    LockFileSystem(true);
+    FreeFileTable(ft);
+    pthread_rwlock_unlock(&FileSystemLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     GetFifoBuffer()
+//  Description :       It is used by stages of a pipeline to work
+//                      on ring of FIFO in place without any copy.
+//                      Writer fills the part and reader consumes
+//                      it, then PutFifoBuffer passes it on. Side
+//                      stays locked till then, so same thread must
+//                      call PutFifoBuffer before next call on side.
+//  Input :             File descriptor, READ or WRITE
+//                      Address of pointer and size to fill
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int GetFifoBuffer(
+                    int fd,             // File descriptor
+                    int mode,           // READ or WRITE
+                    char **ptr,         // Start of part of ring
+                    long long *size     // Size of part of ring
+                 )
+{
+    PFILETABLE ft = NULL;
+    int iRet = 0;
+
+    if(fd < 0 || fd >= MAXOPENFILES || ptr == NULL || size == NULL || (mode != READ && mode != WRITE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(false);
+
+    ft = uareaobj.UFDT[fd];
+
+    if(ft == NULL || ft->ptrinode->FileType != SPECIALFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ft->Mode & mode) == 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    // Table must outlive close by other thread while waiting for ring
+    __atomic_add_fetch(&ft->References,1,__ATOMIC_ACQ_REL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    iRet = FifoBegin(ft,mode,(ft->Mode & NONBLOCK) == 0,ptr,size);
+
+    // Part is remembered under side lock, PutFifoBuffer can not pass on more
+    if((iRet == EXECUTE_SUCCESS) && (*size > 0))
+    {
+        if(mode == WRITE)
+        {
+            ft->FifoWriteTaken = *size;
+        }
+        else
+        {
+            ft->FifoReadTaken = *size;
+        }
+    }
+
+    PutFileTable(ft);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     PutFifoBuffer()
+//  Description :       It is used to pass on the part of ring taken
+//                      by GetFifoBuffer. Size can not be more than
+//                      that part.
+//  Input :             File descriptor, READ or WRITE and bytes
+//                      written or consumed
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int PutFifoBuffer(
+                    int fd,             // File descriptor
+                    int mode,           // READ or WRITE
+                    long long size      // Bytes written or consumed
+                 )
+{
+    PFILETABLE ft = NULL;
+    long long *pTaken = NULL;
+
+    if(fd < 0 || fd >= MAXOPENFILES || size < 0 || (mode != READ && mode != WRITE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(false);
+
+    ft = uareaobj.UFDT[fd];
+
+    if(ft == NULL || ft->ptrinode->FileType != SPECIALFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ft->Mode & mode) == 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pTaken = (mode == WRITE) ? &ft->FifoWriteTaken : &ft->FifoReadTaken;
+
+    // Only part taken by GetFifoBuffer can be passed on, else ring breaks
+    if((*pTaken < 0) || (size > *pTaken))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    *pTaken = -1;
+
+    __atomic_add_fetch(&ft->References,1,__ATOMIC_ACQ_REL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    FifoEnd(ft,mode,size);
+
+    PutFileTable(ft);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CommitWrite()
+//  Description :       It is used to copy data into allocated
+//                      blocks of file and to update checksums
+//                      and size of file
+//  Input :             Inode, offset, data and its size
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CommitWrite(
+                    PINODE inode,       // Inode of file
+                    long long offset,   // Offset in file
+                    const char *data,   // Data to write
+                    long long size      // Size of data
+                )
+{
+    if(size <= 0)
+    {
+        return;
+    }
+
+    CopyToFile(inode,offset,data,size);
+    UpdateChecksum(inode,offset,size);
+    MarkBlocksDirty(inode,offset,size);
+
+    if(offset + size > inode->ActualFileSize)
+    {
+        inode->ActualFileSize = offset + size;
+        MarkSizeChanged(inode);
+    }
+
+    superobj.WriteCommits++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CommitWriteBuffer()
+//  Description :       It is used to move small writes collected
+//                      in write behind buffer of file table to
+//                      blocks of file
+//  Input :             File table
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CommitWriteBuffer(
+                        PFILETABLE ft       // File table
+                      )
+{
+    if(ft->BufferLength == 0)
+    {
+        return;
+    }
+
+    CommitWrite(ft->ptrinode,ft->BufferOffset,ft->WriteBuffer,ft->BufferLength);
+
+    ft->BufferLength = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     HasBufferedWrites()
+//  Description :       It is used to check whether any file table
+//                      holds uncommitted writes of given file
+//  Input :             Inode of file or NULL for all files
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool HasBufferedWrites(
+                        PINODE inode        // Inode of file or NULL
+                      )
+{
+    int i = 0;
+
+    for(i = 0; i < MAXOPENFILES; i++)
+    {
+        if((uareaobj.UFDT[i] != NULL) && (uareaobj.UFDT[i]->BufferLength > 0) &&
+           ((inode == NULL) || (uareaobj.UFDT[i]->ptrinode == inode)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CommitBufferedWrites()
+//  Description :       It is used to commit write behind buffers
+//                      of all file tables of given file. Lock
+//                      must be held for write.
+//  Input :             Inode of file or NULL for all files
+//                      File table which is to be skipped
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CommitBufferedWrites(
+                            PINODE inode,       // Inode of file or NULL
+                            PFILETABLE except   // Table to skip or NULL
+                         )
+{
+    int i = 0;
+
+    for(i = 0; i < MAXOPENFILES; i++)
+    {
+        if((uareaobj.UFDT[i] != NULL) && (uareaobj.UFDT[i] != except) &&
+           ((inode == NULL) || (uareaobj.UFDT[i]->ptrinode == inode)))
+        {
+            CommitWriteBuffer(uareaobj.UFDT[i]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SyncBufferedWrites()
+//  Description :       It is used to make all uncommitted writes
+//                      visible before a whole file system operation
+//                      such as ls or grep
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void SyncBufferedWrites()
+{
+    LockFileSystem(true);
+
+    CommitBufferedWrites(NULL,NULL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BufferWrite()
+//  Description :       It is used to collect small sequential
+//                      write in write behind buffer. Buffer never
+//                      crosses end of block, so each commit
+//                      touches one block and one checksum.
+//  Input :             File table, offset, data and its size
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void BufferWrite(
+                    PFILETABLE ft,      // File table
+                    long long offset,   // Offset in file
+                    const char *data,   // Data to write
+                    long long size      // Size of data
+                )
+{
+    long long lRoom = 0;
+
+    // Write does not continue the buffered run
+    if((ft->BufferLength > 0) && (ft->BufferOffset + ft->BufferLength != offset))
+    {
+        CommitWriteBuffer(ft);
+    }
+
+    if(ft->WriteBuffer == NULL)
+    {
+        ft->WriteBuffer = (char *)malloc(BLOCKSIZE);
+    }
+
+    while(size > 0)
+    {
+        if(ft->BufferLength == 0)
+        {
+            ft->BufferOffset = offset;
+        }
+
+        lRoom = BLOCKSIZE - (ft->BufferOffset % BLOCKSIZE) - ft->BufferLength;
+
+        if(lRoom > size)
+        {
+            lRoom = size;
+        }
+
+        memcpy(ft->WriteBuffer + ft->BufferLength,data,lRoom);
+
+        ft->BufferLength = ft->BufferLength + lRoom;
+        offset = offset + lRoom;
+        data = data + lRoom;
+        size = size - lRoom;
+
+        // Block is complete
+        if((ft->BufferOffset + ft->BufferLength) % BLOCKSIZE == 0)
+        {
+            CommitWriteBuffer(ft);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReadAhead()
+//  Description :       It is used to detect sequential reader and
+//                      to prefetch blocks ahead of it. Window
+//                      starts at MINREADAHEAD blocks and doubles
+//                      on every sequential read up to MAXREADAHEAD.
+//                      Next window is fetched when reader passes
+//                      half of current one. Random read resets it.
+//                      Offset lock of file table must be held.
+//  Input :             File table, offset and size of read
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReadAhead(
+                PFILETABLE ft,      // File table
+                long long offset,   // Offset of read
+                long long size      // Size of read
+              )
+{
+    PINODE inode = ft->ptrinode;
+    long long lFirst = offset / BLOCKSIZE;
+    long long lLast = (offset + size - 1) / BLOCKSIZE;
+    long long lWindow = 0;
+
+    if(offset != ft->LastReadEnd)
+    {
+        ft->ReadAhead = 0;
+        ft->ReadAheadEnd = 0;
+    }
+    else if(ft->ReadAhead == 0)
+    {
+        ft->ReadAhead = MINREADAHEAD;
+    }
+
+    ft->LastReadEnd = offset + size;
+
+    if(Cache.ImageFd == -1)
+    {
+        return;
+    }
+
+    // Blocks of this read itself are brought in by as few calls as possible
+    if(lLast > lFirst)
+    {
+        PrefetchBlocks(inode,lFirst,lLast - lFirst + 1);
+    }
+
+    if((ft->ReadAhead == 0) || ((offset + size) + (ft->ReadAhead * BLOCKSIZE) / 2 < ft->ReadAheadEnd))
+    {
+        return;
+    }
+
+    // Window never takes more than A1in share of page cache
+    lWindow = ft->ReadAhead;
+
+    if(lWindow > Cache.Limit / 4)
+    {
+        lWindow = Cache.Limit / 4;
+    }
+
+    if(ft->ReadAheadEnd < offset + size)
+    {
+        ft->ReadAheadEnd = ((offset + size + BLOCKSIZE - 1) / BLOCKSIZE) * BLOCKSIZE;
+    }
+
+    PrefetchBlocks(inode,ft->ReadAheadEnd / BLOCKSIZE,lWindow);
+
+    ft->ReadAheadEnd = ft->ReadAheadEnd + (lWindow * BLOCKSIZE);
+
+    if(ft->ReadAhead < MAXREADAHEAD)
+    {
+        ft->ReadAhead = ft->ReadAhead * 2;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     NameNewInode
+//  Description :       It is used to make unused inode an empty
+//                      regular file with given name. Quota must be
+//                      charged already. File system lock must be
+//                      held.
+//  Input :             File name, permissions and unused inode
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void NameNewInode(
+                    const char *name,   // Name of new file
+                    int permission,     // Permission for that file
+                    PINODE temp         // Unused inode
+                 )
+{
+    // Initialise elements of Inode
+    temp->FileSize = 0;        // Blocks are allocated by write
+    temp->ActualFileSize = 0;
+    temp->Blocks = 0;
+    temp->FileType = REGULARFILE;
+    temp->LinkCount = 0;
+    temp->ReferenceCount = 0;
+    temp->Permission = permission;
+    TouchInode(temp);
+
+    // Reference of directory entry
+    AddDirEntry(name,temp);
+
+    superobj.FreeInodes--;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CreateInode
+//  Description :       It is used to give new empty regular file a
+//                      name. File system lock must be held.
+//  Input :             File name, permissions and address where
+//                      inode is returned
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CreateInode(
+                    char *name,         // Name of new file
+                    int permission,     // Permission for that file
+                    PPINODE inode       // Created inode
+               )
+{
+    PINODE temp = NULL;
+
+    // If the inodes are full
+    if(superobj.FreeInodes == 0)
+    {
+        return ERR_NO_INODES;
+    }
+
+    // If file is already present
+    if(IsFileExist(name) == true)
+    {
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    // Search empty Inode
+    temp = AllocateInode();
+
+    if(temp == NULL)
+    {
+        printf("There is no inode\n");
+        return ERR_NO_INODES;
+    }
+
+    // Session or directory has used all of its inodes
+    ColdInode(temp)->Owner = uareaobj.Quota;
+
+    if(ChargeFile(temp,0,1) != EXECUTE_SUCCESS)
+    {
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    NameNewInode(name,permission,temp);
+
+    *inode = temp;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CreateFile
+//  Description :       It is used to create new regular file
+//  Input :             It accepts file name and permissions
+//  Output :            It returns the file descriptor
+//  Author :            Shravani Kishor Darandale
+//  Date :              16/01/2026
+//
+//////////////////////////////////////////////////////////
+
+int CreateFile(
+                    char *name,         // Name of new file
+                    int permission      // Permission for that file
+                )
+{
+    PINODE temp = NULL;
+    int i = 0;
+    int iRet = 0;
+    EVENT_SCOPE(EV_CREATEFILE,permission);
 
     printf("Total number of Inodes remaining : %d\n",superobj.FreeInodes);
 
-    // If name is missing
-    if(name == NULL)
-    {
-        return ERR_INVALID_PARAMETER;
-    }
+    // If name is missing or too long
+    if(IsValidName(name) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    // If the permission value is wrong
+    // permission -> 1 -> READ
+    // permission -> 2 -> WRITE
+    // permission -> 3 -> READ + WRITE
+    if(permission < 1 || permission > 3)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    // Search for empty UFDT entry
+    // Note : 0,1,2 are reserved
+    for(i = 3; i < MAXOPENFILES; i++)
+    {
+        if(uareaobj.UFDT[i] == NULL)
+        {
+            break;
+        }
+    }
+
+    // UFDT is full
+    if(i == MAXOPENFILES)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_MAX_FILES_OPEN;
+    }
+
+    iRet = CreateInode(name,permission,&temp);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return iRet;
+    }
+
+    // Allocate ememory for file table
+    uareaobj.UFDT[i] = (PFILETABLE)malloc(sizeof(FILETABLE));
+
+    // Initialise File table
+    uareaobj.UFDT[i]->ReadOffset = 0;
+    uareaobj.UFDT[i]->WriteOffset = 0;
+    uareaobj.UFDT[i]->Mode = permission;
+    uareaobj.UFDT[i]->LastReadEnd = 0;
+    uareaobj.UFDT[i]->ReadAhead = 0;
+    uareaobj.UFDT[i]->ReadAheadEnd = 0;
+    uareaobj.UFDT[i]->WriteBuffer = NULL;
+    uareaobj.UFDT[i]->BufferOffset = 0;
+    uareaobj.UFDT[i]->BufferLength = 0;
+    uareaobj.UFDT[i]->FifoWriteTaken = -1;
+    uareaobj.UFDT[i]->FifoReadTaken = -1;
+    uareaobj.UFDT[i]->References = 1;
+    uareaobj.UFDT[i]->View = NULL;
+    pthread_mutex_init(&uareaobj.UFDT[i]->OffsetLock,NULL);
+    uareaobj.UFDT[i]->ViewShadow = NULL;
+    
+    // Connect File table with Inode
+    uareaobj.UFDT[i]->ptrinode = temp;
+    temp->ReferenceCount++;     // Reference of file table
+
+    // Descriptor is recorded so that replay can map it
+    TraceCall(TRACE_CREATE,i,0,permission,name,NULL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return i;   // File descriptor
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MakeNameFormat
+//  Description :       It is used to check pattern of bulk command
+//                      and to turn it into format for long long.
+//                      Pattern has exactly one %d, which may have
+//                      width such as %06d.
+//  Input :             Pattern and buffer of MAXNAMELENGTH + 8 bytes
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool MakeNameFormat(
+                        const char *pattern,    // Such as file_%d
+                        char *format            // Receives file_%lld
+                   )
+{
+    const char *ptr = NULL;
+    int iLength = 0;
+
+    if((IsValidName(pattern) == false) || ((ptr = strchr(pattern,'%')) == NULL) || (strchr(ptr + 1,'%') != NULL))
+    {
+        return false;
+    }
+
+    ptr++;
+
+    while((*ptr >= '0') && (*ptr <= '9'))
+    {
+        ptr++;
+    }
+
+    if(*ptr != 'd')
+    {
+        return false;
+    }
+
+    iLength = ptr - pattern;
+
+    memcpy(format,pattern,iLength);
+    strcpy(format + iLength,"lld");
+    strcat(format,ptr + 1);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CreateFiles()
+//  Description :       It is used to create many empty files whose
+//                      names are pattern with numbers of range.
+//                      All files are created under one lock, quota
+//                      is charged once and one walk over DILB finds
+//                      all inodes. Files are not opened. Names which
+//                      are present already are skipped.
+//  Input :             Pattern, range and permission
+//  Output :            Number of files created or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long CreateFiles(
+                        const char *pattern,    // Such as file_%d
+                        long long first,        // First number
+                        long long last,         // Last number
+                        int permission          // Permission of files
+                     )
+{
+    char Format[MAXNAMELENGTH + 8] = {'\0'};
+    char Name[MAXNAMELENGTH + 32] = {'\0'};
+    PINODE temp = head;
+    long long lCount = last - first + 1;
+    long long lCreated = 0;
+    long long i = 0;
+
+    if((MakeNameFormat(pattern,Format) == false) || (first < 0) || (first > last) ||
+       (permission < 1) || (permission > 3))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    if(lCount > superobj.FreeInodes)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_NO_INODES;
+    }
+
+    // Inodes of all names are charged at once, skipped ones are given back
+    if(ChargeQuota(uareaobj.Quota,0,lCount) != EXECUTE_SUCCESS)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    if(ChargeQuota(&DirectoryQuota,0,lCount) != EXECUTE_SUCCESS)
+    {
+        ChargeQuota(uareaobj.Quota,0,-lCount);
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    TraceCall(TRACE_CREATEMANY,permission,first,last,pattern,NULL);
+
+    for(i = first; i <= last; i++)
+    {
+        ReportProgress(i - first,last - first + 1);
+
+        snprintf(Name,sizeof(Name),Format,i);
+
+        if((strlen(Name) > MAXNAMELENGTH) || (IsFileExist(Name) == true))
+        {
+            continue;
+        }
+
+        // Walk over DILB goes on from inode used last time
+        while((temp != NULL) && (temp->FileType != 0))
+        {
+            temp = NextInode(temp);
+        }
+
+        if(temp == NULL)
+        {
+            temp = ExtendDILB();
+        }
+
+        ColdInode(temp)->Owner = uareaobj.Quota;
+
+        NameNewInode(Name,permission,temp);
+
+        lCreated++;
+    }
+
+    ChargeQuota(uareaobj.Quota,0,lCreated - lCount);
+    ChargeQuota(&DirectoryQuota,0,lCreated - lCount);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return lCreated;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MakeFifo
+//  Description :       It is used to create new FIFO file whose
+//                      data is a bounded ring buffer
+//  Input :             Name of FIFO
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int MakeFifo(
+                char *name      // Name of new FIFO
+            )
+{
+    PINODE temp = NULL;
+
+    if(IsValidName(name) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_MKFIFO,-1,0,0,name,NULL);
+
+    LockFileSystem(true);
+
+    if(IsFileExist(name) == true)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    temp = AllocateInode();
+
+    if(temp == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_NO_INODES;
+    }
+
+    // Ring of FIFO is charged as its data
+    ColdInode(temp)->Owner = uareaobj.Quota;
+
+    if(ChargeFile(temp,FIFOSIZE,1) != EXECUTE_SUCCESS)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    ColdInode(temp)->Fifo = CreateFifo();
+
+    if(ColdInode(temp)->Fifo == NULL)
+    {
+        ChargeFile(temp,-FIFOSIZE,-1);
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    temp->FileSize = 0;
+    temp->ActualFileSize = 0;
+    temp->Blocks = 0;
+    temp->FileType = SPECIALFILE;
+    temp->LinkCount = 0;
+    temp->ReferenceCount = 0;
+    temp->Permission = READ + WRITE;
+
+    AddDirEntry(name,temp);
+
+    superobj.FreeInodes--;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ListOrder
+//  Description :       It is used to find order of listing by its name
+//  Input :             Name of order
+//  Output :            LIST_NAME, LIST_SIZE, LIST_INODE or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ListOrder(
+                const char *name    // name, size or inode
+              )
+{
+    if(strcmp(name,"name") == 0)
+    {
+        return LIST_NAME;
+    }
+    else if(strcmp(name,"size") == 0)
+    {
+        return LIST_SIZE;
+    }
+    else if(strcmp(name,"inode") == 0)
+    {
+        return LIST_INODE;
+    }
+
+    return -1;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     OpenListing
+//  Description :       It is used to place cursor before first file
+//                      of given order. Output buffer is kept.
+//  Input :             Cursor and order
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void OpenListing(
+                    PLISTCURSOR cursor,     // Position of listing
+                    int order               // LIST_NAME, LIST_SIZE or LIST_INODE
+                )
+{
+    cursor->Order = order;
+    cursor->Started = false;
+    cursor->Done = false;
+    cursor->Value = 0;
+    cursor->Number = 0;
+    cursor->Name[0] = '\0';
+    cursor->Length = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ListEntry
+//  Description :       It is used to add line of one name to output
+//                      of listing. Lock must be held.
+//  Input :             Cursor and directory entry
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ListEntry(
+                PLISTCURSOR cursor,     // Position of listing
+                PDIRENTRY entry         // Name to list
+              )
+{
+    PINODE inode = entry->ptrinode;
+    long long lSize = 0;
+
+    // Longest line is name and five numbers
+    if(cursor->Length + MAXNAMELENGTH + 128 > cursor->Capacity)
+    {
+        cursor->Capacity = (cursor->Capacity == 0) ? LISTBUFFER : cursor->Capacity * 2;
+        cursor->Output = (char *)realloc(cursor->Output,cursor->Capacity);
+    }
+
+    // Size of FIFO is the data waiting in its ring
+    lSize = (inode->FileType == SPECIALFILE) ? (ColdInode(inode)->Fifo->Head - ColdInode(inode)->Fifo->Tail) : inode->ActualFileSize;
+
+    cursor->Length += sprintf(cursor->Output + cursor->Length,"%d\t%s%s\t%lld\t%lld\t%d\n",inode->InodeNumber,entry->FileName->Text,
+                              (inode->FileType == SPECIALFILE) ? "|" : "",lSize,inode->Blocks,inode->LinkCount);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ListPage
+//  Description :       It is used to list next page of files after
+//                      cursor. Lock is held only for this page, so
+//                      files may be created, written and removed
+//                      between pages. Names of one inode stay on
+//                      same page in size and inode order.
+//  Input :             Cursor and number of files
+//  Output :            Number of files listed
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ListPage(
+                PLISTCURSOR cursor,     // Position of listing
+                int count               // Files of page
+            )
+{
+    PINDEXNODE node = NULL;
+    PDIRENTRY entry = NULL;
+    PINODE inode = NULL;
+    int iListed = 0;
+    int i = 0;
+
+    if(cursor->Done == true)
+    {
+        return 0;
+    }
+
+    LockFileSystem(false);
+
+    if(cursor->Order == LIST_INODE)
+    {
+        for(i = cursor->Number; (i < superobj.ReadyInodes) && (iListed < count); i++)
+        {
+            inode = &InodeTable[i];
+
+            for(entry = ColdInode(inode)->Entries; entry != NULL; entry = entry->nextname)
+            {
+                ListEntry(cursor,entry);
+                iListed++;
+            }
+        }
+
+        cursor->Number = i;
+        cursor->Done = (i >= superobj.ReadyInodes);
+    }
+    else
+    {
+        node = SeekIndex((cursor->Order == LIST_NAME) ? &NameIndex : &SizeIndex,cursor);
+
+        for(; (node != NULL) && (iListed < count); node = node->next[0])
+        {
+            if(cursor->Order == LIST_NAME)
+            {
+                ListEntry(cursor,(PDIRENTRY)node->Item);
+                iListed++;
+            }
+            else
+            {
+                for(entry = ColdInode((PINODE)node->Item)->Entries; entry != NULL; entry = entry->nextname)
+                {
+                    ListEntry(cursor,entry);
+                    iListed++;
+                }
+            }
+
+            cursor->Value = node->Value;
+            cursor->Number = node->Number;
+
+            if(node->Name != NULL)
+            {
+                strcpy(cursor->Name,node->Name->Text);
+            }
+        }
+
+        cursor->Done = (node == NULL);
+    }
+
+    cursor->Started = true;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return iListed;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LsFile()
+//  Description :       It is used to list files in order of cursor.
+//                      Files are listed page by page and printed
+//                      in large chunks.
+//  Input :             Cursor and number of files, -1 for all
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+// ls -l
+void LsFile(
+                PLISTCURSOR cursor,     // Position of listing
+                int count               // Files to list, -1 for all
+           )
+{
+    int iListed = 0;
+
+    printf("-----------------------------------------------\n");
+    printf("------ Marvellous CVFS Files Information ------\n");
+    printf("-----------------------------------------------\n");
+
+    SyncBufferedWrites();
+
+    if((cursor->Order == LIST_SIZE) && (SizeIndex.Stale != NULL))
+    {
+        LockFileSystem(true);
+        RefreshSizeIndex();
+        pthread_rwlock_unlock(&FileSystemLock);
+    }
+
+    while((cursor->Done == false) && ((count < 0) || (iListed < count)))
+    {
+        iListed += ListPage(cursor,((count < 0) || (count - iListed > LISTPAGE)) ? LISTPAGE : count - iListed);
+
+        if((cursor->Length >= LISTBUFFER / 2) || (cursor->Done == true))
+        {
+            fwrite(cursor->Output,1,cursor->Length,stdout);
+            cursor->Length = 0;
+        }
+    }
+
+    fwrite(cursor->Output,1,cursor->Length,stdout);
+    cursor->Length = 0;
+
+    printf("-----------------------------------------------\n");
+
+    if(cursor->Done == false)
+    {
+        printf("Use ls next for more files\n");
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DeleteDirEntry
+//  Description :       It is used to free directory entry which is
+//                      removed from name index and to drop its
+//                      reference of inode. Lock must be held.
+//  Input :             Removed directory entry
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DeleteDirEntry(
+                    PDIRENTRY entry     // Removed entry
+                   )
+{
+    entry->ptrinode->LinkCount--;
+
+    //Data is freed only if this was the last reference
+    //Opened file tables of this inode remains valid
+    ReleaseInode(entry->ptrinode);
+
+    ReleaseName(entry->FileName);
+    free(entry);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnlinkFile()
+//  Description :       It is used to delete the file
+//  Input :             File Name
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              22/01/2026
+//
+//////////////////////////////////////////////////////////
+
+int UnlinkFile(
+                char * name
+              )
+{
+   PDIRENTRY entry = NULL;
+   EVENT_SCOPE(EV_UNLINKFILE,0);
+
+   if(name == NULL)
+   {
+    return ERR_INVALID_PARAMETER;
+   }
+
+   TraceCall(TRACE_UNLINK,-1,0,0,name,NULL);
+
+   LockFileSystem(true);
+
+   //Remove the name from directory
+   entry = RemoveDirEntry(name);
+
+   if(entry == NULL)
+   {
+    pthread_rwlock_unlock(&FileSystemLock);
+    return ERR_FILE_NOT_EXIST;
+   }
+
+   DeleteDirEntry(entry);
+
+   pthread_rwlock_unlock(&FileSystemLock);
+
+   return EXECUTE_SUCCESS;
+
+} //End of Function
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnlinkFiles()
+//  Description :       It is used to delete names which are pattern
+//                      with numbers of range under one lock
+//  Input :             Pattern and range
+//  Output :            Number of names deleted or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long UnlinkFiles(
+                        const char *pattern,    // Such as file_%d
+                        long long first,        // First number
+                        long long last          // Last number
+                     )
+{
+    char Format[MAXNAMELENGTH + 8] = {'\0'};
+    char Name[MAXNAMELENGTH + 32] = {'\0'};
+    PDIRENTRY entry = NULL;
+    long long lDeleted = 0;
+    long long i = 0;
+
+    if((MakeNameFormat(pattern,Format) == false) || (first < 0) || (first > last))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    TraceCall(TRACE_UNLINKMANY,-1,first,last,pattern,NULL);
+
+    for(i = first; i <= last; i++)
+    {
+        ReportProgress(i - first,last - first + 1);
+
+        snprintf(Name,sizeof(Name),Format,i);
+
+        entry = RemoveDirEntry(Name);
+
+        if(entry != NULL)
+        {
+            DeleteDirEntry(entry);
+            lDeleted++;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return lDeleted;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnlinkMatching()
+//  Description :       It is used to delete all names which match
+//                      shell pattern with * ? and [ ]. Name index
+//                      is walked once and entries are unlinked in
+//                      place.
+//  Input :             Pattern
+//  Output :            Number of names deleted or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long UnlinkMatching(
+                            const char *pattern     // Such as file_*
+                        )
+{
+    PDIRENTRY *pprev = NULL;
+    PDIRENTRY temp = NULL;
+    long long lDeleted = 0;
+    int i = 0;
+
+    if(IsValidName(pattern) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    TraceCall(TRACE_UNLINKMATCH,-1,0,0,pattern,NULL);
+
+    for(i = 0; i < DIRHASHSIZE; i++)
+    {
+        ReportProgress(i,DIRHASHSIZE);
+
+        pprev = &DirectoryHash[i];
+
+        while(*pprev != NULL)
+        {
+            temp = *pprev;
+
+            if(fnmatch(pattern,temp->FileName->Text,0) != 0)
+            {
+                pprev = &temp->next;
+                continue;
+            }
+
+            *pprev = temp->next;
+            temp->next = NULL;
+
+            UnindexDirEntry(temp);
+            DeleteDirEntry(temp);
+            lDeleted++;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return lDeleted;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WalkHostDirectory
+//  Description :      It is used to collect regular files of host
+//                      directory and of all directories below it.
+//                      Symbolic links are not followed.
+//  Input :            Ingest job, path of directory and offset of
+//                      name part of paths
+//  Output :           EXECUTE_SUCCESS or ERR_FILE_NOT_EXIST
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int WalkHostDirectory(
+                        PINGESTJOB job,     // Files are added here
+                        const char *path,   // Host directory
+                        int offset          // Name starts here in paths
+                     )
+{
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    struct stat sb;
+    char *Path = NULL;
+    int iLength = strlen(path);
+    int iType = 0;
+
+    dir = opendir(path);
+
+    if(dir == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    while((entry = readdir(dir)) != NULL)
+    {
+        if((strcmp(entry->d_name,".") == 0) || (strcmp(entry->d_name,"..") == 0))
+        {
+            continue;
+        }
+
+        Path = (char *)malloc(iLength + strlen(entry->d_name) + 2);
+        sprintf(Path,"%s/%s",path,entry->d_name);
+
+        iType = entry->d_type;
+
+        // Some host file systems do not fill type of entry
+        if((iType == DT_UNKNOWN) && (lstat(Path,&sb) == 0))
+        {
+            iType = S_ISDIR(sb.st_mode) ? DT_DIR : (S_ISREG(sb.st_mode) ? DT_REG : DT_LNK);
+        }
+
+        if(iType == DT_DIR)
+        {
+            WalkHostDirectory(job,Path,offset);
+            free(Path);
+            continue;
+        }
+
+        if(iType != DT_REG)
+        {
+            free(Path);
+            continue;
+        }
+
+        if(job->Count == job->Capacity)
+        {
+            job->Capacity = (job->Capacity == 0) ? 1024 : job->Capacity * 2;
+            job->Files = (PINGESTFILE)realloc(job->Files,job->Capacity * sizeof(INGESTFILE));
+        }
+
+        job->Files[job->Count].Path = Path;
+        job->Files[job->Count].NameOffset = offset;
+        job->Files[job->Count].Data = NULL;
+        job->Files[job->Count].Size = 0;
+        job->Count++;
+    }
+
+    closedir(dir);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReadHostFile
+//  Description :      It is used to read whole host file into
+//                      memory. No lock is held.
+//  Input :            File found by walk
+//  Output :           true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool ReadHostFile(
+                    PINGESTFILE file    // File found by walk
+                 )
+{
+    struct stat sb;
+    long long lRead = 0;
+    ssize_t iRet = 0;
+    int fd = open(file->Path,O_RDONLY);
+
+    if(fd == -1)
+    {
+        return false;
+    }
+
+    if((fstat(fd,&sb) == -1) || (S_ISREG(sb.st_mode) == false))
+    {
+        close(fd);
+        return false;
+    }
+
+    file->Size = sb.st_size;
+    file->Data = (char *)malloc((file->Size > 0) ? file->Size : 1);
+
+    while(lRead < file->Size)
+    {
+        iRet = read(fd,file->Data + lRead,file->Size - lRead);
+
+        if(iRet <= 0)
+        {
+            break;
+        }
+
+        lRead = lRead + iRet;
+    }
+
+    close(fd);
+
+    // File shrank while it was read
+    file->Size = lRead;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IngestBatch
+//  Description :      It is used to put read host files into CVFS.
+//                      Whole batch is inserted under one hold of
+//                      lock, inodes are taken by one walk over DILB.
+//  Input :            Ingest job, first file and number of files
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void IngestBatch(
+                    PINGESTJOB job,     // Shared state of ingest
+                    long long first,    // First file of batch
+                    long long count     // Files of batch
+                )
+{
+    PINGESTFILE file = NULL;
+    PINODE temp = NULL;
+    const char *name = NULL;
+    long long i = 0;
+    int iRet = 0;
+
+    LockFileSystem(true);
+
+    temp = job->NextFree;
+
+    for(i = first; (i < first + count) && (job->Error == EXECUTE_SUCCESS); i++)
+    {
+        file = &job->Files[i];
+        name = file->Path + file->NameOffset;
+
+        if((file->Data == NULL) || (IsValidName(name) == false) || (IsFileExist((char *)name) == true))
+        {
+            job->Skipped++;
+            continue;
+        }
+
+        if(superobj.FreeInodes == 0)
+        {
+            __atomic_store_n(&job->Error,ERR_NO_INODES,__ATOMIC_RELAXED);
+            break;
+        }
+
+        while((temp != NULL) && (temp->FileType != 0))
+        {
+            temp = NextInode(temp);
+        }
+
+        // Inodes freed behind the walk are found from head again
+        if(temp == NULL)
+        {
+            temp = AllocateInode();
+        }
+
+        ColdInode(temp)->Owner = uareaobj.Quota;
+
+        if(ChargeFile(temp,0,1) != EXECUTE_SUCCESS)
+        {
+            __atomic_store_n(&job->Error,ERR_QUOTA_EXCEEDED,__ATOMIC_RELAXED);
+            break;
+        }
+
+        NameNewInode((char *)name,READ + WRITE,temp);
+
+        iRet = GrowFile(temp,file->Size);
+
+        if(iRet == EXECUTE_SUCCESS)
+        {
+            iRet = FillHoles(temp,0,file->Size);
+        }
+
+        // File without its data is not left behind
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            DeleteDirEntry(RemoveDirEntry(name));
+            __atomic_store_n(&job->Error,iRet,__ATOMIC_RELAXED);
+            break;
+        }
+
+        CommitWrite(temp,0,file->Data,file->Size);
+
+        TraceCall(TRACE_INGEST,-1,0,file->Size,name,NULL);
+
+        job->Ingested++;
+        job->Bytes += file->Size;
+    }
+
+    job->NextFree = temp;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IngestThread
+//  Description :      It is used to claim batches of host files,
+//                      read them without lock and put them into
+//                      CVFS till all files are claimed
+//  Input :            Ingest job
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * IngestThread(
+                        void *arg   // Shared ingest job
+                    )
+{
+    PINGESTJOB job = (PINGESTJOB)arg;
+    long long lFirst = 0;
+    long long lCount = 0;
+    long long i = 0;
+
+    while(__atomic_load_n(&job->Error,__ATOMIC_RELAXED) == EXECUTE_SUCCESS)
+    {
+        lFirst = __sync_fetch_and_add(&job->NextFile,INGESTBATCH);
+
+        if(lFirst >= job->Count)
+        {
+            break;
+        }
+
+        lCount = (job->Count - lFirst < INGESTBATCH) ? (job->Count - lFirst) : INGESTBATCH;
+
+        // Host reads of all workers overlap, only inserts are serial
+        for(i = lFirst; i < lFirst + lCount; i++)
+        {
+            ReadHostFile(&job->Files[i]);
+        }
+
+        IngestBatch(job,lFirst,lCount);
+
+        for(i = lFirst; i < lFirst + lCount; i++)
+        {
+            free(job->Files[i].Data);
+            job->Files[i].Data = NULL;
+        }
+
+        ReportProgress(lFirst + lCount,job->Count);
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IngestDirectory()
+//  Description :      It is used to copy regular files of host
+//                      directory tree into CVFS. Tree is walked
+//                      first, then files are read in parallel by
+//                      worker threads and inserted in batches.
+//                      Name of file is its path below directory.
+//  Input :            Host directory and address of job to fill
+//  Output :           Number of files ingested or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long IngestDirectory(
+                            const char *path,   // Host directory
+                            PINGESTJOB job      // Filled with counts
+                         )
+{
+    pthread_t Threads[INGESTTHREADS];
+    int iThreads = 0;
+    int iLength = 0;
+    long long i = 0;
+    char *Path = NULL;
+
+    memset(job,0,sizeof(INGESTJOB));
+
+    if((path == NULL) || (path[0] == '\0'))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    Path = strdup(path);
+    iLength = strlen(Path);
+
+    while((iLength > 1) && (Path[iLength - 1] == '/'))
+    {
+        Path[--iLength] = '\0';
+    }
+
+    if(WalkHostDirectory(job,Path,iLength + 1) != EXECUTE_SUCCESS)
+    {
+        free(Path);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    free(Path);
+
+    job->NextFree = head;
+
+    // Reads wait for host I/O, so threads may exceed CPUs
+    iThreads = 2 * sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(iThreads > INGESTTHREADS)
+    {
+        iThreads = INGESTTHREADS;
+    }
+    if(iThreads > (job->Count + INGESTBATCH - 1) / INGESTBATCH)
+    {
+        iThreads = (job->Count + INGESTBATCH - 1) / INGESTBATCH;
+    }
+
+    for(i = 1; i < iThreads; i++)
+    {
+        pthread_create(&Threads[i],NULL,IngestThread,job);
+    }
+
+    // Current thread also works as one of the workers
+    IngestThread(job);
+
+    for(i = 1; i < iThreads; i++)
+    {
+        pthread_join(Threads[i],NULL);
+    }
+
+    for(i = 0; i < job->Count; i++)
+    {
+        free(job->Files[i].Path);
+    }
+
+    free(job->Files);
+    job->Files = NULL;
+
+    return (job->Error != EXECUTE_SUCCESS) ? job->Error : job->Ingested;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     OpenFile()
+//  Description :       It is used to open the existing file
+//  Input :             File name and mode
+//  Output :            File descriptor
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int OpenFile(
+                char *name,     // Name of file
+                int mode        // READ, WRITE or both
+            )
+{
+    PDIRENTRY entry = NULL;
+    int i = 0;
+    EVENT_SCOPE(EV_OPENFILE,mode);
+
+    // Append is a way of writing, it needs WRITE as well
+    if(name == NULL || (mode & ~(READ + WRITE + APPEND + NONBLOCK)) != 0 || (mode & (READ + WRITE)) == 0 ||
+       ((mode & APPEND) != 0 && (mode & WRITE) == 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    entry = LookupDirEntry(name);
+
+    if(entry == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    // Mode must be allowed by permission of file
+    if((mode & entry->ptrinode->Permission) != (mode & (READ + WRITE)))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    // Note : 0,1,2 are reserved
+    for(i = 3; i < MAXOPENFILES; i++)
+    {
+        if(uareaobj.UFDT[i] == NULL)
+        {
+            break;
+        }
+    }
+
+    if(i == MAXOPENFILES)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_MAX_FILES_OPEN;
+    }
+
+    uareaobj.UFDT[i] = (PFILETABLE)malloc(sizeof(FILETABLE));
+
+    uareaobj.UFDT[i]->ReadOffset = 0;
+    uareaobj.UFDT[i]->WriteOffset = 0;
+    uareaobj.UFDT[i]->Mode = mode;
+    uareaobj.UFDT[i]->ptrinode = entry->ptrinode;
+
+    if(entry->ptrinode->FileType == SPECIALFILE)
+    {
+        // Counts are read without lock by FIFO calls which wait
+        __atomic_add_fetch(&ColdInode(entry->ptrinode)->Fifo->Readers,((mode & READ) != 0),__ATOMIC_ACQ_REL);
+        __atomic_add_fetch(&ColdInode(entry->ptrinode)->Fifo->Writers,((mode & WRITE) != 0),__ATOMIC_ACQ_REL);
+    }
+    uareaobj.UFDT[i]->LastReadEnd = 0;
+    uareaobj.UFDT[i]->ReadAhead = 0;
+    uareaobj.UFDT[i]->ReadAheadEnd = 0;
+    uareaobj.UFDT[i]->WriteBuffer = NULL;
+    uareaobj.UFDT[i]->BufferOffset = 0;
+    uareaobj.UFDT[i]->BufferLength = 0;
+    uareaobj.UFDT[i]->FifoWriteTaken = -1;
+    uareaobj.UFDT[i]->FifoReadTaken = -1;
+    uareaobj.UFDT[i]->References = 1;
+    uareaobj.UFDT[i]->View = NULL;
+    pthread_mutex_init(&uareaobj.UFDT[i]->OffsetLock,NULL);
+    uareaobj.UFDT[i]->ViewShadow = NULL;
+
+    entry->ptrinode->ReferenceCount++;
+
+    TraceCall(TRACE_OPEN,i,0,mode,name,NULL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return i;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LoadView
+//  Description :       It is used to fill mapped view from file and
+//                      to keep copy of it to find changed bytes.
+//                      Part of view after end of file reads as zeros.
+//                      Lock must be held for write.
+//  Input :             File table
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void LoadView(
+                PFILETABLE ft       // File table with view
+             )
+{
+    long long lData = ft->ptrinode->ActualFileSize - ft->ViewOffset;
+
+    if(lData > ft->ViewLength)
+    {
+        lData = ft->ViewLength;
+    }
+
+    if(lData < 0)
+    {
+        lData = 0;
+    }
+
+    CopyFromFile(ft->ptrinode,ft->ViewOffset,ft->View,lData);
+    memset(ft->View + lData,0,ft->ViewLength - lData);
+
+    if(ft->ViewShadow != NULL)
+    {
+        memcpy(ft->ViewShadow,ft->View,ft->ViewLength);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SyncView
+//  Description :       It is used to write changed blocks of mapped
+//                      view back to file. Block is changed when any
+//                      byte differs from copy taken at loading.
+//                      Runs of changed blocks are written as one
+//                      write, part after end of file is dropped.
+//                      View is loaded again so that it shows writes
+//                      of other descriptors. Each written run is
+//                      recorded as store into view. Lock must be
+//                      held for write.
+//  Input :             File table and its descriptor
+//  Output :            Number of blocks written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long SyncView(
+                    PFILETABLE ft,      // File table with view
+                    int fd              // Descriptor of file table
+                  )
+{
+    PINODE inode = ft->ptrinode;
+    long long lBlocks = (ft->ViewLength + BLOCKSIZE - 1) / BLOCKSIZE;
+    long long lDirty = 0;
+    long long lStart = 0;
+    long long lEnd = 0;
+    long long lChunk = 0;
+    long long i = 0;
+    long long j = 0;
+    int iRet = 0;
+
+    // Read only view can not be changed
+    if((ft->Mode & WRITE) == 0)
+    {
+        return 0;
+    }
+
+    CommitBufferedWrites(inode,NULL);
+
+    for(i = 0; i < lBlocks; i = j)
+    {
+        j = i + 1;
+
+        lChunk = ((i + 1) * BLOCKSIZE > ft->ViewLength) ? ft->ViewLength - i * BLOCKSIZE : BLOCKSIZE;
+
+        if(memcmp(ft->View + i * BLOCKSIZE,ft->ViewShadow + i * BLOCKSIZE,lChunk) == 0)
+        {
+            continue;
+        }
+
+        while(j < lBlocks)
+        {
+            lChunk = ((j + 1) * BLOCKSIZE > ft->ViewLength) ? ft->ViewLength - j * BLOCKSIZE : BLOCKSIZE;
+
+            if(memcmp(ft->View + j * BLOCKSIZE,ft->ViewShadow + j * BLOCKSIZE,lChunk) == 0)
+            {
+                break;
+            }
+
+            j++;
+        }
+
+        // File may be truncated after it was mapped
+        lStart = ft->ViewOffset + i * BLOCKSIZE;
+        lEnd = ft->ViewOffset + ((j * BLOCKSIZE > ft->ViewLength) ? ft->ViewLength : j * BLOCKSIZE);
+
+        if(lEnd > inode->ActualFileSize)
+        {
+            lEnd = inode->ActualFileSize;
+        }
+
+        if(lStart >= lEnd)
+        {
+            continue;
+        }
+
+        iRet = FaultIn(inode);
+
+        if(iRet == EXECUTE_SUCCESS)
+        {
+            iRet = FillHoles(inode,lStart,lEnd - lStart);
+        }
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            return iRet;
+        }
+
+        CommitWrite(inode,lStart,ft->View + (lStart - ft->ViewOffset),lEnd - lStart);
+
+        TraceCall(TRACE_MSTORE,fd,lStart - ft->ViewOffset,lEnd - lStart,NULL,NULL);
+
+        lDirty = lDirty + j - i;
+    }
+
+    if(lDirty > 0)
+    {
+        TouchInode(inode);
+    }
+
+    LoadView(ft);
+
+    superobj.MapSyncs++;
+    superobj.MapDirtyBlocks = superobj.MapDirtyBlocks + lDirty;
+
+    return lDirty;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseView
+//  Description :       It is used to give memory of mapped view
+//                      back to OS. Changes which are not synced
+//                      are lost.
+//  Input :             File table
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReleaseView(
+                    PFILETABLE ft       // File table with view
+                )
+{
+    if(ft->View == NULL)
+    {
+        return;
+    }
+
+    munmap(ft->View,((ft->ViewLength + BLOCKSIZE - 1) / BLOCKSIZE) * BLOCKSIZE);
+    free(ft->ViewShadow);
+
+    ft->View = NULL;
+    ft->ViewShadow = NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CloseFile()
+//  Description :       It is used to close the opened file,
+//                      mapped view is synced and unmapped. File
+//                      stays open with its view when changes of
+//                      view can not be written.
+//  Input :             File descriptor
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CloseFile(
+                int fd      // File descriptor
+             )
+{
+    PFILETABLE ft = NULL;
+    long long lRet = 0;
+    EVENT_SCOPE(EV_CLOSEFILE,fd);
+
+    if(fd < 0 || fd >= MAXOPENFILES)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    if(uareaobj.UFDT[fd] == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    CommitWriteBuffer(uareaobj.UFDT[fd]);
+
+    // Changes in mapped view reach file as on msync
+    if(uareaobj.UFDT[fd]->View != NULL)
+    {
+        lRet = SyncView(uareaobj.UFDT[fd],fd);
+
+        if(lRet < 0)
+        {
+            pthread_rwlock_unlock(&FileSystemLock);
+            return (int)lRet;
+        }
+
+        ReleaseView(uareaobj.UFDT[fd]);
+    }
+
+    TraceCall(TRACE_CLOSE,fd,0,0,NULL,NULL);
+
+    // Other side of FIFO must notice that this side is gone
+    if(uareaobj.UFDT[fd]->ptrinode->FileType == SPECIALFILE)
+    {
+        __atomic_sub_fetch(&ColdInode(uareaobj.UFDT[fd]->ptrinode)->Fifo->Readers,((uareaobj.UFDT[fd]->Mode & READ) != 0),__ATOMIC_ACQ_REL);
+        __atomic_sub_fetch(&ColdInode(uareaobj.UFDT[fd]->ptrinode)->Fifo->Writers,((uareaobj.UFDT[fd]->Mode & WRITE) != 0),__ATOMIC_ACQ_REL);
+
+        FifoWake(ColdInode(uareaobj.UFDT[fd]->ptrinode)->Fifo);
+    }
+
+    // Sleeper waiting for these locks may go on
+    ReleaseLocks(fd,uareaobj.UFDT[fd]->ptrinode);
+
+    ft = uareaobj.UFDT[fd];
+    uareaobj.UFDT[fd] = NULL;
+
+    // FIFO call still running without lock frees table when it returns
+    if(__atomic_sub_fetch(&ft->References,1,__ATOMIC_ACQ_REL) == 0)
+    {
+        FreeFileTable(ft);
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LinkFile()
+//  Description :       It is used to create new name for
+//                      existing file. Data is not copied.
+//  Input :             Existing name and new name
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int LinkFile(
+                char *oldname,      // Existing name
+                char *newname       // New name
+            )
+{
+    PDIRENTRY entry = NULL;
+
+    if(oldname == NULL || IsValidName(newname) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_LINK,-1,0,0,oldname,newname);
+
+    LockFileSystem(true);
+
+    entry = LookupDirEntry(oldname);
+
+    if(entry == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if(LookupDirEntry(newname) != NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    AddDirEntry(newname,entry->ptrinode);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RenameFile()
+//  Description :       It is used to change the name of file.
+//                      If new name already exists, that name
+//                      is unlinked first.
+//  Input :             Old name and new name
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int RenameFile(
+                char *oldname,      // Existing name
+                char *newname       // New name
+              )
+{
+    PDIRENTRY entry = NULL;
+    PDIRENTRY target = NULL;
+    unsigned int iBucket = 0;
+
+    if(oldname == NULL || IsValidName(newname) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_RENAME,-1,0,0,oldname,newname);
+
+    LockFileSystem(true);
+
+    entry = LookupDirEntry(oldname);
+
+    if(entry == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    target = LookupDirEntry(newname);
+
+    // Both names already refer to same file, nothing to do
+    if(target != NULL && target->ptrinode == entry->ptrinode)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return EXECUTE_SUCCESS;
+    }
+
+    if(target != NULL)
+    {
+        RemoveDirEntry(newname);
+        target->ptrinode->LinkCount--;
+        ReleaseInode(target->ptrinode);
+        ReleaseName(target->FileName);
+        free(target);
+    }
+
+    // Move the same entry to bucket of its new name
+    RemoveDirEntry(oldname);
+    ReleaseName(entry->FileName);
+    entry->FileName = InternName(newname);
+
+    iBucket = entry->FileName->Hash % DIRHASHSIZE;
+    entry->next = DirectoryHash[iBucket];
+    DirectoryHash[iBucket] = entry;
+
+    IndexDirEntry(entry);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CopyFile()
+//  Description :       It is used to create copy of file which
+//                      shares all data blocks of source. Blocks are
+//                      copied only when one of the files writes them.
+//  Input :             Name of source and name of copy
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CopyFile(
+                char *oldname,      // Name of source file
+                char *newname       // Name of copy
+            )
+{
+    PDIRENTRY entry = NULL;
+    PINODE source = NULL;
+    PINODE temp = NULL;
+    long long lMapBlocks = 0;
+    long long i = 0;
+    int iRet = 0;
+
+    if((oldname == NULL) || (IsValidName(newname) == false))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_COPY,-1,0,0,oldname,newname);
+
+    LockFileSystem(true);
+
+    entry = LookupDirEntry(oldname);
+
+    if(entry == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    source = entry->ptrinode;
+
+    if(source->FileType != REGULARFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if((source->Permission & READ) == 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    // Copy sees all data written so far
+    CommitBufferedWrites(source,NULL);
+
+    iRet = FaultIn(source);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = CreateInode(newname,source->Permission,&temp);
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return iRet;
+    }
+
+    // Copy is charged for its size even while blocks are shared
+    if(ChargeFile(temp,source->Blocks * BLOCKSIZE,0) != EXECUTE_SUCCESS)
+    {
+        entry = RemoveDirEntry(newname);
+
+        entry->ptrinode->LinkCount--;
+        ReleaseInode(entry->ptrinode);
+
+        ReleaseName(entry->FileName);
+        free(entry);
+
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_QUOTA_EXCEEDED;
+    }
+
+    lMapBlocks = BlockCount(source);
+
+    if(lMapBlocks > 0)
+    {
+        temp->BlockMap = (long long *)malloc(lMapBlocks * sizeof(long long));
+        memcpy(temp->BlockMap,source->BlockMap,lMapBlocks * sizeof(long long));
+        ColdInode(temp)->BlockMapSize = lMapBlocks;
+    }
+
+    for(i = 0; i < lMapBlocks; i++)
+    {
+        if(temp->BlockMap[i] != HOLEBLOCK)
+        {
+            Pool.Shares[temp->BlockMap[i]]++;
+            Pool.SharedBlocks++;
+        }
+    }
+
+    temp->FileSize = source->FileSize;
+    temp->ActualFileSize = source->ActualFileSize;
+    temp->Blocks = source->Blocks;
+
+    MarkSizeChanged(temp);
+
+    // Shared blocks are not written by copy, checkpoint takes them all
+    ColdInode(temp)->CheckpointAll = true;
+
+    Pool.Copies++;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WriteFile()
+//  Description :       It is used to write the data into the file.
+//                      Writes smaller than a block are collected
+//                      in write behind buffer of file table.
+//  Input :             File Descriptor
+//                      Address of Buffer which contains data
+//                      Size of data that we want to write
+//  Output :            Number of bytes successfully written
+//  Author :            Shravani Kishor Darandale
+//  Date :              22/01/2026
+//
+//////////////////////////////////////////////////////////
+
+long long WriteFile(
+                int fd,
+                char *data,
+                long long size
+            )
+{
+  PFILETABLE ft = NULL;
+  long long lRet = 0;
+  int iRet = 0;
+  EVENT_SCOPE(EV_WRITEFILE,size);
+
+  //Invalid FD
+  if(fd < 0 || fd >= MAXOPENFILES || data == NULL || size < 0)
+  {
+    return ERR_INVALID_PARAMETER;
+  }
+
+  LockFileSystem(true);
+
+  //FD points to NULL
+  if (uareaobj.UFDT[fd] == NULL)
+  {
+    pthread_rwlock_unlock(&FileSystemLock);
+    return ERR_FILE_NOT_EXIST;
+  }
+  
+  TraceCall(TRACE_WRITE,fd,uareaobj.UFDT[fd]->WriteOffset,size,NULL,NULL);
+
+  //There is no permission to write
+  if((uareaobj.UFDT[fd]->Mode & WRITE) == 0)
+  {
+    pthread_rwlock_unlock(&FileSystemLock);
+    return ERR_PERMISSION_DENIED;
+  }
+
+  //FIFO is served by its ring without file system lock, table is kept
+  //alive by reference in case other thread closes it meanwhile
+  if(uareaobj.UFDT[fd]->ptrinode->FileType == SPECIALFILE)
+  {
+    ft = uareaobj.UFDT[fd];
+    __atomic_add_fetch(&ft->References,1,__ATOMIC_ACQ_REL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    lRet = FifoWrite(ft,data,size);
+    PutFileTable(ft);
+
+    return lRet;
+  }
+
+  //Older buffered data of other descriptors must not overwrite this one
+  CommitBufferedWrites(uareaobj.UFDT[fd]->ptrinode,uareaobj.UFDT[fd]);
+
+  //Cold file comes back to memory before it is changed
+  iRet = FaultIn(uareaobj.UFDT[fd]->ptrinode);
+
+  if(iRet != EXECUTE_SUCCESS)
+  {
+    pthread_rwlock_unlock(&FileSystemLock);
+    return iRet;
+  }
+
+  TouchInode(uareaobj.UFDT[fd]->ptrinode);
+
+  //Append lands at end of file, own buffered data included
+  if((uareaobj.UFDT[fd]->Mode & APPEND) != 0)
+  {
+    uareaobj.UFDT[fd]->WriteOffset = uareaobj.UFDT[fd]->ptrinode->ActualFileSize;
+
+    if((uareaobj.UFDT[fd]->BufferLength > 0) &&
+       (uareaobj.UFDT[fd]->BufferOffset + uareaobj.UFDT[fd]->BufferLength > uareaobj.UFDT[fd]->WriteOffset))
+    {
+      uareaobj.UFDT[fd]->WriteOffset = uareaobj.UFDT[fd]->BufferOffset + uareaobj.UFDT[fd]->BufferLength;
+    }
+  }
+
+  //Insufficient Space or quota, blocks are allocated even for buffered data
+  //Gap between end of file and offset stays a hole
+  iRet = GrowFile(uareaobj.UFDT[fd]->ptrinode,uareaobj.UFDT[fd]->WriteOffset + size);
+
+  if(iRet == EXECUTE_SUCCESS)
+  {
+    iRet = FillHoles(uareaobj.UFDT[fd]->ptrinode,uareaobj.UFDT[fd]->WriteOffset,size);
+  }
+
+  if(iRet != EXECUTE_SUCCESS)
+  {
+    pthread_rwlock_unlock(&FileSystemLock);
+    return iRet;
+  }
+
+  superobj.WriteCalls++;
+
+  //Write the data into the file
+  if(size < BLOCKSIZE)
+  {
+    BufferWrite(uareaobj.UFDT[fd],uareaobj.UFDT[fd]->WriteOffset,data,size);
+  }
+  else
+  {
+    CommitWriteBuffer(uareaobj.UFDT[fd]);
+    CommitWrite(uareaobj.UFDT[fd]->ptrinode,uareaobj.UFDT[fd]->WriteOffset,data,size);
+  }
+
+  //Update the writeoffset
+  uareaobj.UFDT[fd]->WriteOffset = uareaobj.UFDT[fd]->WriteOffset + size;
+
+  pthread_rwlock_unlock(&FileSystemLock);
+
+  return size;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReadFile()
+//  Description :       It is used to read the data into the file
+//  Input :             File Descriptor
+//                      Address of Empty Buffer which contains data
+//                      Size of data that we want to read
+//  Output :            Number of bytes successfully read
+//  Author :            Shravani Kishor Darandale
+//  Date :              22/01/2026
+//
+//////////////////////////////////////////////////////////
+
+long long ReadFile(
+               int fd,
+               char *data,
+               long long size
+            )
+{
+    PFILETABLE ft = NULL;
+    long long lRet = 0;
+    int iRet = EXECUTE_SUCCESS;
+    EVENT_SCOPE(EV_READFILE,size);
+
+    //Invalid fd
+    if(fd < 0 || fd >= MAXOPENFILES)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(data == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(size <= 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(false);
+
+    if(uareaobj.UFDT[fd] == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    //Small writes of this file may still wait in write behind buffers
+    //and data of cold file may be in backing file
+    while((HasBufferedWrites(uareaobj.UFDT[fd]->ptrinode) == true) || (ColdInode(uareaobj.UFDT[fd]->ptrinode)->Spilled == true))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        LockFileSystem(true);
+
+        if(uareaobj.UFDT[fd] != NULL)
+        {
+            CommitBufferedWrites(uareaobj.UFDT[fd]->ptrinode,NULL);
+            iRet = FaultIn(uareaobj.UFDT[fd]->ptrinode);
+        }
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            return iRet;
+        }
+
+        LockFileSystem(false);
+
+        if(uareaobj.UFDT[fd] == NULL)
+        {
+            pthread_rwlock_unlock(&FileSystemLock);
+            return ERR_FILE_NOT_EXIST;
+        }
+    }
+
+    TouchInode(uareaobj.UFDT[fd]->ptrinode);
+
+    ft = uareaobj.UFDT[fd];
+
+    //Readers sharing descriptor take turns on its offset and readahead
+    pthread_mutex_lock(&ft->OffsetLock);
+
+    TraceCall(TRACE_READ,fd,ft->ReadOffset,size,NULL,NULL);
+
+    //Filter for permission
+    if((ft->Mode & READ) == 0)
+    {
+        pthread_mutex_unlock(&ft->OffsetLock);
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    //FIFO gives what is present instead of exactly size bytes, table is
+    //kept alive by reference in case other thread closes it meanwhile
+    if(ft->ptrinode->FileType == SPECIALFILE)
+    {
+        pthread_mutex_unlock(&ft->OffsetLock);
+        __atomic_add_fetch(&ft->References,1,__ATOMIC_ACQ_REL);
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        lRet = FifoRead(ft,data,size);
+        PutFileTable(ft);
+
+        return lRet;
+    }
+
+    //Insufficient data
+    if((ft->ptrinode->ActualFileSize - ft->ReadOffset) < size)
+    {
+        pthread_mutex_unlock(&ft->OffsetLock);
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INSUFFICIENT_DATA;
+    }
+
+    __atomic_add_fetch(&superobj.ReadCalls,1,__ATOMIC_RELAXED);
+
+    ReadAhead(ft,ft->ReadOffset,size);
+
+    //Data must be same as it was written
+    if(VerifyChecksum(ft->ptrinode,ft->ReadOffset,size) != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&ft->OffsetLock);
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_CHECKSUM_MISMATCH;
+    }
+
+    //Read the data
+    CopyFromFile(ft->ptrinode,ft->ReadOffset,data,size);
+
+    //Update the readoffset
+    ft->ReadOffset = ft->ReadOffset + size;
+
+    pthread_mutex_unlock(&ft->OffsetLock);
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return size;
+
+
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     MapFile()
+//  Description :       It is used to map part of opened file into
+//                      contiguous memory which can be read and
+//                      changed in place. View of read only
+//                      descriptor is read only. Earlier view of
+//                      descriptor is synced and replaced.
+//  Input :             File descriptor, offset which is multiple of
+//                      block size, length or 0 for rest of file and
+//                      address where view is returned
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int MapFile(
+                int fd,             // File descriptor
+                long long offset,   // Start of view in file
+                long long length,   // Bytes of view, 0 for rest of file
+                char **view         // Receives address of view
+           )
+{
+    PFILETABLE ft = NULL;
+    char *ptr = NULL;
+    char *shadow = NULL;
+    long long lSize = 0;
+    long long lRet = 0;
+    int iRet = 0;
+
+    if((fd < 0) || (fd >= MAXOPENFILES) || (view == NULL) || (offset < 0) || (offset % BLOCKSIZE != 0) || (length < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    ft = uareaobj.UFDT[fd];
+
+    if(ft == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ft->Mode & READ) == 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    if(ft->ptrinode->FileType != REGULARFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    CommitBufferedWrites(ft->ptrinode,NULL);
+
+    // Like mmap, view can not start or end after end of file
+    if(length == 0)
+    {
+        length = ft->ptrinode->ActualFileSize - offset;
+    }
+
+    if((length <= 0) || (offset + length > ft->ptrinode->ActualFileSize))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INSUFFICIENT_DATA;
+    }
+
+    iRet = FaultIn(ft->ptrinode);
+
+    if((iRet == EXECUTE_SUCCESS) && (VerifyChecksum(ft->ptrinode,offset,length) != EXECUTE_SUCCESS))
+    {
+        iRet = ERR_CHECKSUM_MISMATCH;
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return iRet;
+    }
+
+    lSize = ((length + BLOCKSIZE - 1) / BLOCKSIZE) * BLOCKSIZE;
+
+    ptr = (char *)mmap(NULL,lSize,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+
+    // Read only view can not change, so it needs no copy
+    if((ptr != MAP_FAILED) && ((ft->Mode & WRITE) != 0))
+    {
+        shadow = (char *)malloc(length);
+
+        if(shadow == NULL)
+        {
+            munmap(ptr,lSize);
+            ptr = (char *)MAP_FAILED;
+        }
+    }
+
+    if(ptr == MAP_FAILED)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    // Remapping keeps changes of old view, old view stays when they
+    // can not be written
+    if(ft->View != NULL)
+    {
+        lRet = SyncView(ft,fd);
+
+        if(lRet < 0)
+        {
+            munmap(ptr,lSize);
+            free(shadow);
+            pthread_rwlock_unlock(&FileSystemLock);
+            return (int)lRet;
+        }
+
+        ReleaseView(ft);
+    }
+
+    ft->View = ptr;
+    ft->ViewOffset = offset;
+    ft->ViewLength = length;
+    ft->ViewShadow = shadow;
+
+    LoadView(ft);
+
+    if((ft->Mode & WRITE) == 0)
+    {
+        mprotect(ptr,lSize,PROT_READ);
+    }
+
+    TouchInode(ft->ptrinode);
+
+    TraceCall(TRACE_MMAP,fd,offset,length,NULL,NULL);
+
+    *view = ptr;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SyncMap()
+//  Description :       It is used to write changes of mapped view
+//                      to file. Readers see either none or all of
+//                      them.
+//  Input :             File descriptor
+//  Output :            Number of changed blocks written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long SyncMap(
+                    int fd      // File descriptor
+                 )
+{
+    long long lRet = 0;
+
+    if(fd < 0 || fd >= MAXOPENFILES)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    if((uareaobj.UFDT[fd] == NULL) || (uareaobj.UFDT[fd]->View == NULL))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    lRet = SyncView(uareaobj.UFDT[fd],fd);
+
+    TraceCall(TRACE_MSYNC,fd,0,0,NULL,NULL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    if((lRet > 0) && (Cache.ImageFd != -1))
+    {
+        FlushCache();
+        fdatasync(Cache.ImageFd);
+    }
+
+    return lRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UnmapFile()
+//  Description :       It is used to sync and remove mapped view
+//  Input :             File descriptor
+//  Output :            Number of changed blocks written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long UnmapFile(
+                    int fd      // File descriptor
+                   )
+{
+    long long lRet = 0;
+
+    if(fd < 0 || fd >= MAXOPENFILES)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    if((uareaobj.UFDT[fd] == NULL) || (uareaobj.UFDT[fd]->View == NULL))
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    lRet = SyncView(uareaobj.UFDT[fd],fd);
+
+    TraceCall(TRACE_MUNMAP,fd,0,0,NULL,NULL);
+
+    // View stays when its changes could not be written
+    if(lRet >= 0)
+    {
+        ReleaseView(uareaobj.UFDT[fd]);
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return lRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ResizeFile()
+//  Description :       It is used to set size of regular file whose
+//                      buffered writes are committed. File system
+//                      lock must be held.
+//  Input :             Inode of file and new size
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ResizeFile(
+                PINODE inode,       // Inode of file
+                long long size      // New size
+              )
+{
+    PINODECOLD cold = ColdInode(inode);
+    long long lBlocks = (size + BLOCKSIZE - 1) / BLOCKSIZE;
+    long long lNewSize = 0;
+    long long lFreed = 0;
+    long long i = 0;
+    char *ptr = NULL;
+    int iRet = FaultIn(inode);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        return iRet;
+    }
+
+    if(size > inode->ActualFileSize)
+    {
+        // Bytes after old end are zero already
+        if(GrowFile(inode,size) != EXECUTE_SUCCESS)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        inode->ActualFileSize = size;
+        MarkSizeChanged(inode);
+
+        return EXECUTE_SUCCESS;
+    }
+
+    lFreed = inode->Blocks;
+    cold->Changes++;
+
+    for(i = lBlocks; i < BlockCount(inode); i++)
+    {
+        if(inode->BlockMap[i] != HOLEBLOCK)
+        {
+            FreeBlock(inode->BlockMap[i]);
+            inode->Blocks--;
+        }
+    }
+
+    ChargeFile(inode,-(lFreed - inode->Blocks) * BLOCKSIZE,0);
+
+    inode->FileSize = lBlocks * BLOCKSIZE;
+    inode->ActualFileSize = size;
+    MarkSizeChanged(inode);
+
+    // Data after end must read as zeros if file grows again
+    if((size % BLOCKSIZE != 0) && (inode->BlockMap[lBlocks - 1] != HOLEBLOCK))
+    {
+        // Copy of file keeps its data after the end
+        if(UnshareBlock(inode,lBlocks - 1) != EXECUTE_SUCCESS)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        ptr = GetBlock(inode->BlockMap[lBlocks - 1],CACHE_READ);
+        memset(ptr + (size % BLOCKSIZE),0,BLOCKSIZE - (size % BLOCKSIZE));
+        PutBlock(ptr,true);
+
+        UpdateChecksum(inode,size - 1,1);
+    }
+
+    // Chunk reserved for growth of large file is not needed now
+    if(cold->HugeLeft > 0)
+    {
+        ReleaseChunk(cold->HugeNext / CHUNKBLOCKS);
+        cold->HugeNext = -1;
+        cold->HugeLeft = 0;
+    }
+
+    // Block map gives back memory once file is a quarter of it
+    lNewSize = cold->BlockMapSize;
+
+    while((lNewSize > 1) && (lBlocks <= lNewSize / 4))
+    {
+        lNewSize = lNewSize / 2;
+    }
+
+    if(lNewSize != cold->BlockMapSize)
+    {
+        inode->BlockMap = (long long *)realloc(inode->BlockMap,lNewSize * sizeof(long long));
+        cold->BlockMapSize = lNewSize;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TruncateFile()
+//  Description :       It is used to change size of file. Blocks
+//                      after new end are given back to pool and
+//                      rest of last block is zeroed. Growing file
+//                      adds a hole.
+//  Input :             Name of file and new size
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int TruncateFile(
+                    char *name,         // Name of file
+                    long long size      // New size
+                )
+{
+    PDIRENTRY entry = NULL;
+    PINODE inode = NULL;
+    int iRet = 0;
+    EVENT_SCOPE(EV_TRUNCATEFILE,size);
+
+    if(name == NULL || size < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_TRUNCATE,-1,0,size,name,NULL);
+
+    LockFileSystem(true);
+
+    entry = LookupDirEntry(name);
+
+    if(entry == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    inode = entry->ptrinode;
+
+    if(inode->FileType == SPECIALFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if((inode->Permission & WRITE) == 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_PERMISSION_DENIED;
+    }
+
+    CommitBufferedWrites(inode,NULL);
+
+    iRet = ResizeFile(inode,size);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BeginTransaction()
+//  Description :       It is used to open batch in which creates,
+//                      writes and unlinks are staged until commit
+//  Input :             Nothing
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int BeginTransaction()
+{
+    if(uareaobj.Transaction != NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    uareaobj.Transaction = (PTRANSACTION)malloc(sizeof(TRANSACTION));
+
+    uareaobj.Transaction->Ops = NULL;
+    uareaobj.Transaction->Count = 0;
+    uareaobj.Transaction->Capacity = 0;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StageOperation()
+//  Description :       It is used to add copy of one operation at
+//                      end of open batch
+//  Input :             Type, file name, permission, data and size
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int StageOperation(
+                    int type,           // TRANSACTION_CREATE, WRITE or UNLINK
+                    const char *name,   // Name of file
+                    int permission,     // Permission of created file
+                    const char *data,   // Data of write or NULL
+                    long long size      // Size of data
+                  )
+{
+    PTRANSACTION txn = uareaobj.Transaction;
+    PTRANSACTIONOP op = NULL;
+
+    if(txn == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    if(txn->Count == txn->Capacity)
+    {
+        txn->Capacity = (txn->Capacity == 0) ? 8 : txn->Capacity * 2;
+        txn->Ops = (PTRANSACTIONOP)realloc(txn->Ops,txn->Capacity * sizeof(TRANSACTIONOP));
+    }
+
+    op = &txn->Ops[txn->Count];
+
+    op->Type = type;
+    op->Name = (char *)malloc(strlen(name) + 1);
+    strcpy(op->Name,name);
+    op->Permission = permission;
+    op->Data = NULL;
+    op->Size = size;
+    op->ptrinode = NULL;
+    op->entry = NULL;
+    op->OldSize = 0;
+
+    if(size > 0)
+    {
+        op->Data = (char *)malloc(size);
+        memcpy(op->Data,data,size);
+    }
+
+    txn->Count++;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     IsStagedName()
+//  Description :       It is used to check whether name exists once
+//                      operations staged so far are applied. Last
+//                      staged create or unlink of name decides,
+//                      else file system is asked.
+//  Input :             File name
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool IsStagedName(
+                    const char *name    // Name of file
+                 )
+{
+    PTRANSACTION txn = uareaobj.Transaction;
+    bool bExist = false;
+    int i = 0;
+
+    for(i = txn->Count - 1; i >= 0; i--)
+    {
+        if((txn->Ops[i].Type != TRANSACTION_WRITE) && (strcmp(txn->Ops[i].Name,name) == 0))
+        {
+            return (txn->Ops[i].Type == TRANSACTION_CREATE);
+        }
+    }
+
+    LockFileSystem(false);
+    bExist = (LookupDirEntry((char *)name) != NULL);
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return bExist;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StageCreate()
+//  Description :       It is used to stage creation of regular file.
+//                      Name must be free when batch reaches it.
+//  Input :             File name and permissions
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int StageCreate(
+                    char *name,         // Name of new file
+                    int permission      // Permission for that file
+               )
+{
+    if((IsValidName(name) == false) || (permission < 1) || (permission > 3))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(uareaobj.Transaction == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    if(IsStagedName(name) == true)
+    {
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    return StageOperation(TRANSACTION_CREATE,name,permission,NULL,0);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StageWrite()
+//  Description :       It is used to stage data which is appended
+//                      at end of file. File must exist when batch
+//                      reaches it.
+//  Input :             File name, data and its size
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int StageWrite(
+                char *name,         // Name of file
+                char *data,         // Data to append
+                long long size      // Size of data
+              )
+{
+    if((IsValidName(name) == false) || (data == NULL) || (size < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(uareaobj.Transaction == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    if(IsStagedName(name) == false)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    return StageOperation(TRANSACTION_WRITE,name,0,data,size);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     StageUnlink()
+//  Description :       It is used to stage deletion of file name.
+//                      Name must exist when batch reaches it.
+//  Input :             File name
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int StageUnlink(
+                char *name      // Name of file
+               )
+{
+    if(IsValidName(name) == false)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(uareaobj.Transaction == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    if(IsStagedName(name) == false)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    return StageOperation(TRANSACTION_UNLINK,name,0,NULL,0);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FreeTransaction()
+//  Description :       It is used to close open batch and free its
+//                      staged operations
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FreeTransaction()
+{
+    int i = 0;
+
+    for(i = 0; i < uareaobj.Transaction->Count; i++)
+    {
+        free(uareaobj.Transaction->Ops[i].Name);
+        free(uareaobj.Transaction->Ops[i].Data);
+    }
+
+    free(uareaobj.Transaction->Ops);
+    free(uareaobj.Transaction);
+
+    uareaobj.Transaction = NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ApplyOperation()
+//  Description :       It is used to apply one staged operation.
+//                      Unlinked entry is only detached, so that it
+//                      can be put back. File system lock must be held.
+//  Input :             Staged operation
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ApplyOperation(
+                    PTRANSACTIONOP op   // Staged operation
+                  )
+{
+    PDIRENTRY entry = NULL;
+    int iRet = 0;
+
+    if(op->Type == TRANSACTION_CREATE)
+    {
+        return CreateInode(op->Name,op->Permission,&op->ptrinode);
+    }
+
+    if(op->Type == TRANSACTION_UNLINK)
+    {
+        op->entry = RemoveDirEntry(op->Name);
+
+        return (op->entry == NULL) ? ERR_FILE_NOT_EXIST : EXECUTE_SUCCESS;
+    }
+
+    entry = LookupDirEntry(op->Name);
+
+    if(entry == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if(entry->ptrinode->FileType == SPECIALFILE)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if((entry->ptrinode->Permission & WRITE) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    op->ptrinode = entry->ptrinode;
+
+    iRet = FaultIn(op->ptrinode);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        return iRet;
+    }
+
+    op->OldSize = op->ptrinode->ActualFileSize;
+    TouchInode(op->ptrinode);
+
+    iRet = GrowFile(op->ptrinode,op->OldSize + op->Size);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = FillHoles(op->ptrinode,op->OldSize,op->Size);
+    }
+
+    // Blocks taken before failure are given back
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        ResizeFile(op->ptrinode,op->OldSize);
+        return iRet;
+    }
+
+    CommitWrite(op->ptrinode,op->OldSize,op->Data,op->Size);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     UndoOperation()
+//  Description :       It is used to revert applied operation.
+//                      Operations are undone in reverse order, so
+//                      file is as it was when operation was applied.
+//  Input :             Applied operation
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void UndoOperation(
+                    PTRANSACTIONOP op   // Applied operation
+                  )
+{
+    PDIRENTRY entry = NULL;
+    unsigned int iBucket = 0;
+
+    if(op->Type == TRANSACTION_CREATE)
+    {
+        entry = RemoveDirEntry(op->Name);
+
+        entry->ptrinode->LinkCount--;
+        ReleaseInode(entry->ptrinode);
+
+        ReleaseName(entry->FileName);
+        free(entry);
+    }
+    else if(op->Type == TRANSACTION_WRITE)
+    {
+        // Appended blocks are freed and quota is given back
+        ResizeFile(op->ptrinode,op->OldSize);
+    }
+    else
+    {
+        iBucket = op->entry->FileName->Hash % DIRHASHSIZE;
+        op->entry->next = DirectoryHash[iBucket];
+        DirectoryHash[iBucket] = op->entry;
+
+        IndexDirEntry(op->entry);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CommitTransaction()
+//  Description :       It is used to apply all staged operations as
+//                      a unit. File system lock is taken once and
+//                      image is synced once for whole batch. If any
+//                      operation fails, applied ones are undone.
+//                      Names are checked again, as other threads
+//                      may change them after staging.
+//  Input :             Nothing
+//  Output :            Number of operations applied or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CommitTransaction()
+{
+    PTRANSACTION txn = uareaobj.Transaction;
+    PDIRENTRY entry = NULL;
+    int iRet = EXECUTE_SUCCESS;
+    int iCount = 0;
+    int i = 0;
+
+    if(txn == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    LockFileSystem(true);
+
+    // Appends must land after data buffered by open files
+    CommitBufferedWrites(NULL,NULL);
+
+    for(i = 0; i < txn->Count; i++)
+    {
+        iRet = ApplyOperation(&txn->Ops[i]);
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        for(i = i - 1; i >= 0; i--)
+        {
+            UndoOperation(&txn->Ops[i]);
+        }
+    }
+    else
+    {
+        // Names are gone for good, drop the files they referred to
+        for(i = 0; i < txn->Count; i++)
+        {
+            if(txn->Ops[i].Type == TRANSACTION_UNLINK)
+            {
+                entry = txn->Ops[i].entry;
+
+                entry->ptrinode->LinkCount--;
+                ReleaseInode(entry->ptrinode);
+
+                ReleaseName(entry->FileName);
+                free(entry);
+            }
+        }
+    }
+
+    // Batch is recorded as staged, replay stages and commits it again
+    for(i = 0; i < txn->Count; i++)
+    {
+        TraceCall(TRACE_BATCHCREATE + txn->Ops[i].Type - TRANSACTION_CREATE,-1,0,
+                  (txn->Ops[i].Type == TRANSACTION_CREATE) ? txn->Ops[i].Permission : txn->Ops[i].Size,txn->Ops[i].Name,NULL);
+    }
+
+    TraceCall(TRACE_COMMIT,-1,0,txn->Count,NULL,NULL);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    if((iRet == EXECUTE_SUCCESS) && (Cache.ImageFd != -1))
+    {
+        FlushCache();
+        fdatasync(Cache.ImageFd);
+    }
+
+    iCount = txn->Count;
+
+    FreeTransaction();
+
+    return (iRet == EXECUTE_SUCCESS) ? iCount : iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AbortTransaction()
+//  Description :       It is used to discard open batch, nothing
+//                      staged in it is applied
+//  Input :             Nothing
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int AbortTransaction()
+{
+    if(uareaobj.Transaction == NULL)
+    {
+        return ERR_TRANSACTION;
+    }
+
+    FreeTransaction();
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FindData()
+//  Description :       It is used to find first offset at or after
+//                      given offset which is not in a hole
+//  Input :             Inode of file and offset
+//  Output :            Offset or ERR_INSUFFICIENT_DATA
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long FindData(
+                    PINODE inode,       // Inode of file
+                    long long offset    // Offset to start from
+                  )
+{
+    long long lBlock = offset / BLOCKSIZE;
+
+    if(offset >= inode->ActualFileSize)
+    {
+        return ERR_INSUFFICIENT_DATA;
+    }
+
+    while((lBlock < BlockCount(inode)) && (inode->BlockMap[lBlock] == HOLEBLOCK))
+    {
+        lBlock++;
+    }
+
+    if(lBlock * BLOCKSIZE >= inode->ActualFileSize)
+    {
+        return ERR_INSUFFICIENT_DATA;
+    }
+
+    return (lBlock * BLOCKSIZE > offset) ? (lBlock * BLOCKSIZE) : offset;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FindHole()
+//  Description :       It is used to find first offset at or after
+//                      given offset which is in a hole. End of file
+//                      is treated as start of a hole.
+//  Input :             Inode of file and offset
+//  Output :            Offset or ERR_INSUFFICIENT_DATA
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long FindHole(
+                    PINODE inode,       // Inode of file
+                    long long offset    // Offset to start from
+                  )
+{
+    long long lBlock = offset / BLOCKSIZE;
+
+    if(offset >= inode->ActualFileSize)
+    {
+        return ERR_INSUFFICIENT_DATA;
+    }
+
+    while((lBlock < BlockCount(inode)) && (inode->BlockMap[lBlock] != HOLEBLOCK))
+    {
+        lBlock++;
+    }
+
+    if(lBlock * BLOCKSIZE >= inode->ActualFileSize)
+    {
+        return inode->ActualFileSize;
+    }
+
+    return (lBlock * BLOCKSIZE > offset) ? (lBlock * BLOCKSIZE) : offset;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LseekFile()
+//  Description :       It is used to change read offset and write
+//                      offset of opened file as per its mode.
+//                      Offset may go past end of file, the gap
+//                      becomes a hole on next write.
+//  Input :             File descriptor, offset and
+//                      START, CURRENT, END, NEXTDATA or NEXTHOLE
+//  Output :            New offset or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long LseekFile(
+                        int fd,             // File descriptor
+                        long long offset,   // Offset
+                        int from            // Position to count from
+                   )
+{
+    PFILETABLE ft = NULL;
+    long long lNew = 0;
+
+    if(fd < 0 || fd >= MAXOPENFILES || from < START || from > NEXTHOLE)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    TraceCall(TRACE_LSEEK,fd,offset,from,NULL,NULL);
+
+    LockFileSystem(true);
+
+    ft = uareaobj.UFDT[fd];
+
+    if(ft == NULL)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    // FIFO has no offsets
+    if(ft->ptrinode->FileType == SPECIALFILE)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    // End of file must include buffered writes
+    CommitBufferedWrites(ft->ptrinode,NULL);
+
+    if(from == START)
+    {
+        lNew = offset;
+    }
+    else if(from == CURRENT)
+    {
+        lNew = (((ft->Mode & READ) != 0) ? ft->ReadOffset : ft->WriteOffset) + offset;
+    }
+    else if(from == END)
+    {
+        lNew = ft->ptrinode->ActualFileSize + offset;
+    }
+    else if(from == NEXTDATA)
+    {
+        lNew = (offset < 0) ? ERR_INVALID_PARAMETER : FindData(ft->ptrinode,offset);
+    }
+    else
+    {
+        lNew = (offset < 0) ? ERR_INVALID_PARAMETER : FindHole(ft->ptrinode,offset);
+    }
+
+    if(lNew < 0)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return (from >= NEXTDATA) ? lNew : ERR_INVALID_PARAMETER;
+    }
+
+    if((ft->Mode & READ) != 0)
+    {
+        ft->ReadOffset = lNew;
+    }
+    if((ft->Mode & WRITE) != 0)
+    {
+        ft->WriteOffset = lNew;
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return lNew;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     AddSearchResult
+//  Description :       It is used to record one matching offset
+//  Input :             Search result of file
+//                      Offset of match
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void AddSearchResult(
+                        PSEARCHRESULT result,   // Result of one file
+                        long long offset        // Offset of match
+                    )
+{
+    if(result->Count == result->Capacity)
+    {
+        result->Capacity = (result->Capacity == 0) ? 8 : result->Capacity * 2;
+        result->Offsets = (long long *)realloc(result->Offsets,result->Capacity * sizeof(long long));
+    }
+
+    result->Offsets[result->Count] = offset;
+    result->Count++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchScalar
+//  Description :       It is used to search the pattern byte by byte
+//                      from given position till end of data
+//  Input :             Data, its length, start position,
+//                      pattern, its length, offset of data
+//                      in file and result
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void SearchScalar(
+                    const char *data,       // Data of file
+                    int length,             // Length of data
+                    int start,              // Position to start from
+                    const char *pattern,    // Pattern to search
+                    int plength,            // Length of pattern
+                    long long base,         // Offset of data in file
+                    PSEARCHRESULT result    // Result of file
+                 )
+{
+    int i = 0;
+
+    for(i = start; i + plength <= length; i++)
+    {
+        if((data[i] == pattern[0]) && (memcmp(data + i,pattern,plength) == 0))
+        {
+            AddSearchResult(result,base + i);
+        }
+    }
+}
+
+#ifdef CVFS_X86
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchSSE2
+//  Description :       It is used to search the pattern 16 bytes
+//                      at a time. First and last byte of pattern
+//                      are compared in parallel and only the
+//                      candidate positions are verified.
+//  Input :             Data, its length, pattern, its length,
+//                      offset of data in file and result
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+__attribute__((target("sse2")))
+void SearchSSE2(
+                    const char *data,       // Data of file
+                    int length,             // Length of data
+                    const char *pattern,    // Pattern to search
+                    int plength,            // Length of pattern
+                    long long base,         // Offset of data in file
+                    PSEARCHRESULT result    // Result of file
+               )
+{
+    __m128i First = _mm_set1_epi8(pattern[0]);
+    __m128i Last = _mm_set1_epi8(pattern[plength - 1]);
+    __m128i BlockFirst, BlockLast;
+    unsigned int Mask = 0;
+    int i = 0, Bit = 0;
+
+    for(i = 0; i + plength - 1 + 16 <= length; i = i + 16)
+    {
+        BlockFirst = _mm_loadu_si128((const __m128i *)(data + i));
+        BlockLast = _mm_loadu_si128((const __m128i *)(data + i + plength - 1));
+
+        Mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(First,BlockFirst),
+                                               _mm_cmpeq_epi8(Last,BlockLast)));
+
+        while(Mask != 0)
+        {
+            Bit = __builtin_ctz(Mask);
+
+            if((plength <= 2) || (memcmp(data + i + Bit + 1,pattern + 1,plength - 2) == 0))
+            {
+                AddSearchResult(result,base + i + Bit);
+            }
+            Mask = Mask & (Mask - 1);
+        }
+    }
+
+    // Remaining tail which is shorter than one vector
+    SearchScalar(data,length,i,pattern,plength,base,result);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchAVX2
+//  Description :       It is used to search the pattern 32 bytes
+//                      at a time using the same technique as SSE2
+//  Input :             Data, its length, pattern, its length,
+//                      offset of data in file and result
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+__attribute__((target("avx2")))
+void SearchAVX2(
+                    const char *data,       // Data of file
+                    int length,             // Length of data
+                    const char *pattern,    // Pattern to search
+                    int plength,            // Length of pattern
+                    long long base,         // Offset of data in file
+                    PSEARCHRESULT result    // Result of file
+               )
+{
+    __m256i First = _mm256_set1_epi8(pattern[0]);
+    __m256i Last = _mm256_set1_epi8(pattern[plength - 1]);
+    __m256i BlockFirst, BlockLast;
+    unsigned int Mask = 0;
+    int i = 0, Bit = 0;
+
+    for(i = 0; i + plength - 1 + 32 <= length; i = i + 32)
+    {
+        BlockFirst = _mm256_loadu_si256((const __m256i *)(data + i));
+        BlockLast = _mm256_loadu_si256((const __m256i *)(data + i + plength - 1));
+
+        Mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(First,BlockFirst),
+                                                                  _mm256_cmpeq_epi8(Last,BlockLast)));
+
+        while(Mask != 0)
+        {
+            Bit = __builtin_ctz(Mask);
+
+            if((plength <= 2) || (memcmp(data + i + Bit + 1,pattern + 1,plength - 2) == 0))
+            {
+                AddSearchResult(result,base + i + Bit);
+            }
+            Mask = Mask & (Mask - 1);
+        }
+    }
+
+    SearchScalar(data,length,i,pattern,plength,base,result);
+}
+
+#endif
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchData
+//  Description :       It is used to search the pattern using
+//                      the widest instruction set of this CPU,
+//                      chosen by InitialiseSearch
+//  Input :             Data, its length, pattern, its length,
+//                      offset of data in file and result
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void SearchData(
+                    const char *data,       // Data of file
+                    int length,             // Length of data
+                    const char *pattern,    // Pattern to search
+                    int plength,            // Length of pattern
+                    long long base,         // Offset of data in file
+                    PSEARCHRESULT result    // Result of file
+               )
+{
+#ifdef CVFS_X86
+    if(SearchLevel == 2)
+    {
+        SearchAVX2(data,length,pattern,plength,base,result);
+        return;
+    }
+    else if(SearchLevel == 1)
+    {
+        SearchSSE2(data,length,pattern,plength,base,result);
+        return;
+    }
+#endif
+
+    SearchScalar(data,length,0,pattern,plength,base,result);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchBoundary
+//  Description :       It is used to find matches which start
+//                      before the given offset and end after it.
+//                      Only these few bytes around the boundary
+//                      of two blocks are copied.
+//  Input :             Inode, offset of boundary, pattern,
+//                      its length and result
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void SearchBoundary(
+                        PINODE inode,           // Inode of file
+                        long long boundary,     // Offset of boundary
+                        const char *pattern,    // Pattern to search
+                        int plength,            // Length of pattern
+                        PSEARCHRESULT result    // Result of file
+                   )
+{
+    char Window[2 * BLOCKSIZE];
+    long long lStart = boundary - (plength - 1);
+    long long lEnd = boundary + (plength - 1);
+    long long i = 0;
+
+    if(lStart < 0)
+    {
+        lStart = 0;
+    }
+    if(lEnd > inode->ActualFileSize)
+    {
+        lEnd = inode->ActualFileSize;
+    }
+
+    CopyFromFile(inode,lStart,Window,lEnd - lStart);
+
+    for(i = lStart; (i < boundary) && (i + plength <= lEnd); i++)
+    {
+        if(memcmp(Window + (i - lStart),pattern,plength) == 0)
+        {
+            AddSearchResult(result,i);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SearchThread
+//  Description :       It is the entry point of search thread.
+//                      Each thread picks next unsearched range of
+//                      blocks and searches it in place. Blocks
+//                      which are contiguous in pool are searched
+//                      as one run. Frames of page cache are not
+//                      contiguous, so with image each block is a
+//                      run of its own.
+//  Input :             Address of shared search job
+//  Output :            NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * SearchThread(
+                        void *arg   // Shared search job
+                   )
+{
+    PSEARCHJOB job = (PSEARCHJOB)arg;
+    PSEARCHRESULT item = NULL;
+    PINODE temp = NULL;
+    char *ptr = NULL;
+    long long lBlock = 0, lRun = 0;
+    long long lStart = 0, lEnd = 0;
+    int i = 0;
+
+    while(1)
+    {
+        i = __sync_fetch_and_add(&job->NextItem,1);
+
+        if(i >= job->ItemCount)
+        {
+            break;
+        }
+
+        // Claimed ranges of all searchers, seen by thread of grep job
+        ReportProgress(i,job->ItemCount);
+
+        item = &job->Results[i];
+        temp = item->ptrinode;
+
+        for(lBlock = item->FirstBlock; lBlock < item->LastBlock; lBlock = lRun)
+        {
+            lRun = lBlock + 1;
+
+            // Pattern has no zero byte, so it can not match in a hole
+            if(temp->BlockMap[lBlock] == HOLEBLOCK)
+            {
+                continue;
+            }
+
+            while((Cache.ImageFd == -1) && (lRun < item->LastBlock) && (temp->BlockMap[lRun] == temp->BlockMap[lRun - 1] + 1))
+            {
+                lRun++;
+            }
+
+            lStart = lBlock * BLOCKSIZE;
+            lEnd = lRun * BLOCKSIZE;
+
+            if(lEnd > temp->ActualFileSize)
+            {
+                lEnd = temp->ActualFileSize;
+            }
+
+            ptr = GetBlock(temp->BlockMap[lBlock],CACHE_READ);
+            SearchData(ptr,lEnd - lStart,job->Pattern,job->PatternLength,lStart,item);
+            PutBlock(ptr,false);
+
+            if((job->PatternLength > 1) && (lEnd < temp->ActualFileSize))
+            {
+                SearchBoundary(temp,lEnd,job->Pattern,job->PatternLength,item);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     GrepFile()
+//  Description :       It is used to search the pattern in
+//                      contents of all files. File whose data can
+//                      not be brought back from backing file is
+//                      listed as not searched.
+//  Input :             Pattern
+//  Output :            Number of matches found
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int GrepFile(
+                char *pattern   // Pattern to search
+            )
+{
+    PINODE temp = head;
+    PDIRENTRY entry = NULL;
+    SEARCHJOB job;
+    pthread_t Threads[MAXSEARCHTHREADS];
+    int *Slot = NULL;       // First range of each inode number
+    long long lBlocks = 0, lBlock = 0;
+    int iThreads = 0;
+    int iTotal = 0;
+    int iSkipped = 0;
+    int iTries = 0;
+    int i = 0, j = 0, k = 0;
+
+    if(pattern == NULL || pattern[0] == '\0' || strlen(pattern) > BLOCKSIZE)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    job.Pattern = pattern;
+    job.PatternLength = strlen(pattern);
+    job.ItemCount = 0;
+    job.NextItem = 0;
+
+    // Spilled files are brought back so that all data is searched. Tier
+    // thread may spill one again before read lock is taken, then it is
+    // brought back again, and reported if it still is spilled.
+    for(iTries = 0; iTries < SEARCHRETRIES; iTries++)
+    {
+        if(iTries > 0)
+        {
+            pthread_rwlock_unlock(&FileSystemLock);
+        }
+
+        LockFileSystem(true);
+
+        CommitBufferedWrites(NULL,NULL);
+
+        for(temp = head; temp != NULL; temp = NextInode(temp))
+        {
+            if(temp->FileType == REGULARFILE)
+            {
+                FaultIn(temp);
+            }
+        }
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        LockFileSystem(false);
+
+        iSkipped = 0;
+
+        for(temp = head; temp != NULL; temp = NextInode(temp))
+        {
+            iSkipped = iSkipped + ((temp->FileType == REGULARFILE) && (temp->ActualFileSize >= job.PatternLength) && (ColdInode(temp)->Spilled == true));
+        }
+
+        if(iSkipped == 0)
+        {
+            break;
+        }
+    }
+
+    // Only initialised inodes can hold files
+    Slot = (int *)malloc((superobj.ReadyInodes + 1) * sizeof(int));
+
+    // Count the ranges of SEARCHBLOCKS blocks of all files
+    for(temp = head; temp != NULL; temp = NextInode(temp))
+    {
+        if((temp->FileType == REGULARFILE) && (temp->ActualFileSize >= job.PatternLength) && (ColdInode(temp)->Spilled == false))
+        {
+            lBlocks = (temp->ActualFileSize + BLOCKSIZE - 1) / BLOCKSIZE;
+            job.ItemCount = job.ItemCount + (lBlocks + SEARCHBLOCKS - 1) / SEARCHBLOCKS;
+        }
+    }
+
+    job.Results = (PSEARCHRESULT)calloc(job.ItemCount + 1,sizeof(SEARCHRESULT));
+    job.ItemCount = 0;
+
+    // Inode having many names is searched only once
+    for(temp = head; temp != NULL; temp = NextInode(temp))
+    {
+        Slot[temp->InodeNumber] = -1;
+
+        if((temp->FileType != REGULARFILE) || (temp->ActualFileSize < job.PatternLength) || (ColdInode(temp)->Spilled == true))
+        {
+            continue;
+        }
+
+        Slot[temp->InodeNumber] = job.ItemCount;
+        lBlocks = (temp->ActualFileSize + BLOCKSIZE - 1) / BLOCKSIZE;
+
+        for(lBlock = 0; lBlock < lBlocks; lBlock = lBlock + SEARCHBLOCKS)
+        {
+            job.Results[job.ItemCount].ptrinode = temp;
+            job.Results[job.ItemCount].FirstBlock = lBlock;
+            job.Results[job.ItemCount].LastBlock = (lBlock + SEARCHBLOCKS < lBlocks) ? (lBlock + SEARCHBLOCKS) : lBlocks;
+            job.ItemCount++;
+        }
+    }
+
+    // One thread per CPU, but never more threads than ranges
+    iThreads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(iThreads > MAXSEARCHTHREADS)
+    {
+        iThreads = MAXSEARCHTHREADS;
+    }
+    if(iThreads > job.ItemCount)
+    {
+        iThreads = job.ItemCount;
+    }
+
+    for(i = 1; i < iThreads; i++)
+    {
+        pthread_create(&Threads[i],NULL,SearchThread,&job);
+    }
+
+    // Current thread also works as one of the searchers
+    SearchThread(&job);
+
+    for(i = 1; i < iThreads; i++)
+    {
+        pthread_join(Threads[i],NULL);
+    }
+
+    // Report matches under every name of the file
+    for(i = 0; i < DIRHASHSIZE; i++)
+    {
+        for(entry = DirectoryHash[i]; entry != NULL; entry = entry->next)
+        {
+            for(k = Slot[entry->ptrinode->InodeNumber]; (k != -1) && (job.Results[k].ptrinode == entry->ptrinode); k++)
+            {
+                for(j = 0; j < job.Results[k].Count; j++)
+                {
+                    printf("%s\t%lld\n",entry->FileName->Text,job.Results[k].Offsets[j]);
+                }
+
+                iTotal = iTotal + job.Results[k].Count;
+            }
+
+            if((iSkipped > 0) && (entry->ptrinode->FileType == REGULARFILE) && (entry->ptrinode->ActualFileSize >= job.PatternLength) && (ColdInode(entry->ptrinode)->Spilled == true))
+            {
+                printf("%s\tnot searched, data could not be brought back from backing file\n",entry->FileName->Text);
+            }
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    for(i = 0; i < job.ItemCount; i++)
+    {
+        free(job.Results[i].Offsets);
+    }
+
+    free(job.Results);
+    free(Slot);
+
+    return iTotal;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SetScrubRate()
+//  Description :       It is used to change the speed of scrub thread
+//  Input :             Blocks per second, 0 to pause scrubbing
+//  Output :            EXECUTE_SUCCESS or ERR_INVALID_PARAMETER
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int SetScrubRate(
+                    int rate    // Blocks per second
+                )
+{
+    if(rate < 0 || rate > 1000000)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    // Scrub thread reads it without lock
+    __atomic_store_n(&superobj.ScrubRate,rate,__ATOMIC_RELAXED);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     HugePageModeName()
+//  Description :       It is used to get printable name of mode
+//  Input :             Huge page mode
+//  Output :            Name of mode
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+const char * HugePageModeName(
+                                int mode    // HUGEPAGE_xxx
+                             )
+{
+    if(mode == HUGEPAGE_TRANSPARENT)
+    {
+        return "transparent";
+    }
+    else if(mode == HUGEPAGE_EXPLICIT)
+    {
+        return "explicit";
+    }
+
+    return "off";
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SetHugePageMode()
+//  Description :       It is used to select backing of chunks
+//                      which are allocated for large files from now
+//  Input :             off, transparent or explicit
+//  Output :            EXECUTE_SUCCESS or ERR_INVALID_PARAMETER
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int SetHugePageMode(
+                        char *mode  // Name of mode
+                   )
+{
+    if(strcmp(mode,"off") == 0)
+    {
+        Pool.HugePageMode = HUGEPAGE_OFF;
+    }
+    else if(strcmp(mode,"transparent") == 0)
+    {
+        Pool.HugePageMode = HUGEPAGE_TRANSPARENT;
+    }
+    else if(strcmp(mode,"explicit") == 0)
+    {
+        Pool.HugePageMode = HUGEPAGE_EXPLICIT;
+    }
+    else
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SetQuota()
+//  Description :       It is used to change limits of quota of
+//                      session or of root directory. Limit below
+//                      current usage only stops further growth.
+//  Input :             Name of quota, byte limit and inode limit
+//  Output :            EXECUTE_SUCCESS or ERR_INVALID_PARAMETER
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int SetQuota(
+                char *name,         // session or root
+                long long bytes,    // Byte limit, 0 for none
+                long long inodes    // Inode limit, 0 for none
+            )
+{
+    PQUOTA quota = NULL;
+
+    if(strcmp(name,"session") == 0)
+    {
+        quota = uareaobj.Quota;
+    }
+    else if(strcmp(name,"root") == 0)
+    {
+        quota = &DirectoryQuota;
+    }
+
+    if((quota == NULL) || (bytes < 0) || (inodes < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&quota->Lock);
+
+    quota->ByteLimit = bytes;
+    quota->InodeLimit = inodes;
+
+    pthread_mutex_unlock(&quota->Lock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SetCacheBudget()
+//  Description :       It is used to change memory budget of page
+//                      cache. On shrink frames are evicted and
+//                      their memory is given back to OS.
+//  Input :             Budget in MB
+//  Output :            EXECUTE_SUCCESS or ERR_INVALID_PARAMETER
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int SetCacheBudget(
+                    int megabytes   // Budget in MB
+                  )
+{
+    int f = 0, i = 0;
+
+    if((Cache.ImageFd == -1) || (megabytes <= 0) || ((long long)megabytes * 1024 * 1024 > MAXCACHESIZE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    Cache.Limit = megabytes * ((1024 * 1024) / BLOCKSIZE);
+
+    while(Cache.InUse > Cache.Limit)
+    {
+        f = ReclaimFrame();
+
+        if(f == -1)
+        {
+            break;
+        }
+
+        Cache.FreeFrames[Cache.FreeCount] = f;
+        Cache.FreeCount++;
+        Cache.InUse--;
+    }
+
+    TrimGhosts(Cache.Limit / 2);
+
+    for(i = 0; i < Cache.FreeCount; i++)
+    {
+        madvise(FrameAddress(Cache.FreeFrames[i]),BLOCKSIZE,MADV_DONTNEED);
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CompareLatency
+//  Description :       It is used by qsort to order latencies
+//  Input :             Addresses of two latencies
+//  Output :            Negative, zero or positive
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CompareLatency(
+                    const void *first,  // First latency
+                    const void *second  // Second latency
+                  )
+{
+    long long lFirst = *(const long long *)first;
+    long long lSecond = *(const long long *)second;
+
+    return (lFirst > lSecond) - (lFirst < lSecond);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TraceOpName
+//  Description :       It is used to get name of recorded call
+//  Input :             Kind of call
+//  Output :            Name
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+const char *TraceOpName(
+                            int op      // TRACE_CREATE and so on
+                       )
+{
+    const char *Names[TRACEOPS] = {"?","creat","open","close","read","write","lseek",
+                                   "unlink","truncate","link","rename","cp","mkfifo",
+                                   "creat *","unlink *","unlink ?","ingest","b creat",
+                                   "b append","b unlink","commit","mmap","mstore","msync",
+                                   "munmap"};
+
+    return ((op > 0) && (op < TRACEOPS)) ? Names[op] : Names[0];
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayReplay
+//  Description :       It is used to display throughput of replay
+//                      and latency distribution of each kind of call
+//  Input :             Latencies of each kind, time taken and
+//                      number of calls
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayReplay(
+                    REPLAYSTAT *Stats,      // TRACEOPS entries
+                    long long elapsed,      // Nano seconds of replay
+                    long long calls         // Calls replayed
+                  )
+{
+    long long lBytes = 0;
+    long long lSum = 0;
+    long long *L = NULL;
+    long long n = 0;
+    long long i = 0;
+    int op = 0;
+
+    printf("Op\t\tCalls\tErrors\tMean us\tp50 us\tp90 us\tp99 us\tMax us\n");
+
+    for(op = 1; op < TRACEOPS; op++)
+    {
+        L = Stats[op].Latency;
+        n = Stats[op].Count;
+
+        if(n == 0)
+        {
+            continue;
+        }
+
+        qsort(L,n,sizeof(long long),CompareLatency);
+
+        for(i = 0, lSum = 0; i < n; i++)
+        {
+            lSum = lSum + L[i];
+        }
+
+        lBytes = lBytes + Stats[op].Bytes;
+
+        printf("%-8s\t%lld\t%lld\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",TraceOpName(op),n,Stats[op].Errors,
+               (double)lSum / n / 1000.0,L[n / 2] / 1000.0,L[(n * 9) / 10] / 1000.0,L[(n * 99) / 100] / 1000.0,L[n - 1] / 1000.0);
+    }
+
+    printf("Replayed %lld calls in %.3f ms : %.0f calls/sec, %.1f MB/sec\n",calls,elapsed / 1000000.0,
+           (elapsed > 0) ? calls / (elapsed / 1000000000.0) : 0.0,
+           (elapsed > 0) ? (lBytes / (1024.0 * 1024.0)) / (elapsed / 1000000000.0) : 0.0);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReplayTrace()
+//  Description :       It is used to execute calls of trace file
+//                      again on empty file system, either as fast as
+//                      possible or at the time they were recorded.
+//                      Descriptors of trace are mapped to the ones
+//                      returned by replayed creat and open. Data of
+//                      writes is not recorded, a pattern is written
+//                      and recorded stores into mapped view flip
+//                      bytes of their run.
+//  Input :             Name of trace file, true for original timing
+//  Output :            Number of calls replayed or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long ReplayTrace(
+                        const char *path,   // Trace file of host
+                        bool timed          // Keep original timing
+                     )
+{
+    REPLAYSTAT Stats[TRACEOPS];
+    int Fds[MAXOPENFILES];
+    TRACERECORD rec;
+    struct timespec ts;
+    char *Map = NULL;
+    char *Data = NULL;
+    char *Name = NULL;
+    char *Other = NULL;
+    char *View = NULL;
+    char Names[2 * MAXNAMELENGTH + 2] = {'\0'};
+    long long lDataSize = 0;
+    long long lSize = 0;
+    long long lPos = 0;
+    long long lStart = 0;
+    long long lBegin = 0;
+    long long lRet = 0;
+    long long lCalls = 0;
+    int fd = 0;
+    int i = 0;
+
+    if(path == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    // Replay must not record itself and needs empty file system
+    if(Trace.Fd != -1)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(superobj.FreeInodes != superobj.TotalInodes)
+    {
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    fd = open(path,O_RDONLY);
+
+    if(fd == -1)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    lSize = lseek(fd,0,SEEK_END);
+
+    if(lSize >= TRACEMAGICSIZE)
+    {
+        Map = (char *)mmap(NULL,lSize,PROT_READ,MAP_PRIVATE,fd,0);
+    }
+
+    close(fd);
+
+    if((Map == NULL) || (Map == MAP_FAILED) || (memcmp(Map,TRACEMAGIC,TRACEMAGICSIZE) != 0))
+    {
+        if((Map != NULL) && (Map != MAP_FAILED))
+        {
+            munmap(Map,lSize);
+        }
+
+        return ERR_INVALID_PARAMETER;
+    }
+
+    madvise(Map,lSize,MADV_SEQUENTIAL);
+
+    memset(Stats,0,sizeof(Stats));
+
+    for(i = 0; i < MAXOPENFILES; i++)
+    {
+        Fds[i] = -1;
+    }
+
+    lBegin = NanoTime();
+
+    for(lPos = TRACEMAGICSIZE; lPos + (long long)sizeof(TRACERECORD) <= lSize; lPos = lPos + sizeof(TRACERECORD) + rec.NameLength)
+    {
+        ReportProgress(lPos,lSize);
+
+        memcpy(&rec,Map + lPos,sizeof(TRACERECORD));
+
+        if((lPos + (long long)sizeof(TRACERECORD) + rec.NameLength > lSize) || (rec.NameLength > sizeof(Names) - 1) ||
+           (rec.Op == 0) || (rec.Op >= TRACEOPS))
+        {
+            break;
+        }
+
+        // Names follow record, second one after zero byte
+        memcpy(Names,Map + lPos + sizeof(TRACERECORD),rec.NameLength);
+        Names[rec.NameLength] = '\0';
+
+        Name = Names;
+        Other = Names + strlen(Names) + 1;
+
+        if(Other > Names + rec.NameLength)
+        {
+            Other = Name;
+        }
+
+        fd = ((rec.Fd >= 0) && (rec.Fd < MAXOPENFILES)) ? Fds[rec.Fd] : -1;
+
+        if(((rec.Op == TRACE_READ) || (rec.Op == TRACE_WRITE) || (rec.Op == TRACE_INGEST) || (rec.Op == TRACE_BATCHWRITE)) &&
+           (rec.Size > lDataSize))
+        {
+            lDataSize = rec.Size;
+            Data = (char *)realloc(Data,lDataSize);
+
+            for(i = 0; i < lDataSize; i++)
+            {
+                Data[i] = 'A' + (i % 26);
+            }
+        }
+
+        if(timed == true)
+        {
+            lStart = lBegin + rec.Time - NanoTime();
+
+            if(lStart > 0)
+            {
+                ts.tv_sec = lStart / 1000000000LL;
+                ts.tv_nsec = lStart % 1000000000LL;
+                nanosleep(&ts,NULL);
+            }
+        }
+
+        lStart = NanoTime();
+
+        switch(rec.Op)
+        {
+            case TRACE_CREATE :
+                lRet = CreateFile(Name,(int)rec.Size);
+                break;
+
+            case TRACE_OPEN :
+                lRet = OpenFile(Name,(int)rec.Size);
+                break;
+
+            case TRACE_CLOSE :
+                lRet = CloseFile(fd);
+                break;
+
+            case TRACE_READ :
+                lRet = ReadFile(fd,Data,rec.Size);
+                break;
+
+            case TRACE_WRITE :
+                lRet = WriteFile(fd,Data,rec.Size);
+                break;
+
+            case TRACE_LSEEK :
+                lRet = LseekFile(fd,rec.Offset,(int)rec.Size);
+                break;
+
+            case TRACE_UNLINK :
+                lRet = UnlinkFile(Name);
+                break;
+
+            case TRACE_TRUNCATE :
+                lRet = TruncateFile(Name,rec.Size);
+                break;
+
+            case TRACE_LINK :
+                lRet = LinkFile(Name,Other);
+                break;
+
+            case TRACE_RENAME :
+                lRet = RenameFile(Name,Other);
+                break;
+
+            case TRACE_COPY :
+                lRet = CopyFile(Name,Other);
+                break;
+
+            case TRACE_MKFIFO :
+                lRet = MakeFifo(Name);
+                break;
+
+            case TRACE_CREATEMANY :
+                lRet = CreateFiles(Name,rec.Offset,rec.Size,rec.Fd);
+                break;
+
+            case TRACE_UNLINKMANY :
+                lRet = UnlinkFiles(Name,rec.Offset,rec.Size);
+                break;
+
+            case TRACE_UNLINKMATCH :
+                lRet = UnlinkMatching(Name);
+                break;
+
+            // Host tree is not needed, file is created with pattern
+            case TRACE_INGEST :
+                lRet = CreateFile(Name,READ + WRITE);
+
+                if(lRet >= 0)
+                {
+                    i = (int)lRet;
+                    lRet = (rec.Size > 0) ? WriteFile(i,Data,rec.Size) : 0;
+                    CloseFile(i);
+                }
+                break;
+
+            case TRACE_BATCHCREATE :
+            case TRACE_BATCHWRITE :
+            case TRACE_BATCHUNLINK :
+                if(uareaobj.Transaction == NULL)
+                {
+                    BeginTransaction();
+                }
+
+                if(rec.Op == TRACE_BATCHCREATE)
+                {
+                    lRet = StageCreate(Name,(int)rec.Size);
+                }
+                else if(rec.Op == TRACE_BATCHWRITE)
+                {
+                    lRet = StageWrite(Name,Data,rec.Size);
+                }
+                else
+                {
+                    lRet = StageUnlink(Name);
+                }
+                break;
+
+            case TRACE_COMMIT :
+                lRet = CommitTransaction();
+                break;
+
+            case TRACE_MMAP :
+                lRet = MapFile(fd,rec.Offset,rec.Size,&View);
+                break;
+
+            // Every byte is flipped so that whole run is written again
+            case TRACE_MSTORE :
+                lRet = ERR_INVALID_PARAMETER;
+
+                if((fd != -1) && (uareaobj.UFDT[fd] != NULL) && (uareaobj.UFDT[fd]->View != NULL) &&
+                   (uareaobj.UFDT[fd]->ViewShadow != NULL) && (rec.Offset >= 0) && (rec.Size >= 0) &&
+                   (rec.Offset + rec.Size <= uareaobj.UFDT[fd]->ViewLength))
+                {
+                    View = uareaobj.UFDT[fd]->View + rec.Offset;
+
+                    for(lRet = 0; lRet < rec.Size; lRet++)
+                    {
+                        View[lRet] = ~View[lRet];
+                    }
+                }
+                break;
+
+            case TRACE_MSYNC :
+                lRet = SyncMap(fd);
+                break;
+
+            case TRACE_MUNMAP :
+                lRet = UnmapFile(fd);
+                break;
+        }
+
+        lStart = NanoTime() - lStart;
+
+        if((rec.Op == TRACE_CREATE || rec.Op == TRACE_OPEN) && (lRet >= 0) && (rec.Fd >= 0) && (rec.Fd < MAXOPENFILES))
+        {
+            Fds[rec.Fd] = (int)lRet;
+        }
+        else if((rec.Op == TRACE_CLOSE) && (fd != -1))
+        {
+            Fds[rec.Fd] = -1;
+        }
+
+        if(Stats[rec.Op].Count == Stats[rec.Op].Capacity)
+        {
+            Stats[rec.Op].Capacity = (Stats[rec.Op].Capacity == 0) ? 64 : Stats[rec.Op].Capacity * 2;
+            Stats[rec.Op].Latency = (long long *)realloc(Stats[rec.Op].Latency,Stats[rec.Op].Capacity * sizeof(long long));
+        }
+
+        Stats[rec.Op].Latency[Stats[rec.Op].Count++] = lStart;
+
+        if(lRet < 0)
+        {
+            Stats[rec.Op].Errors++;
+        }
+        else if((rec.Op == TRACE_READ) || (rec.Op == TRACE_WRITE) || (rec.Op == TRACE_INGEST) || (rec.Op == TRACE_MSTORE))
+        {
+            Stats[rec.Op].Bytes = Stats[rec.Op].Bytes + lRet;
+        }
+
+        lCalls++;
+    }
+
+    lBegin = NanoTime() - lBegin;
+
+    DisplayReplay(Stats,lBegin,lCalls);
+
+    for(i = 0; i < TRACEOPS; i++)
+    {
+        free(Stats[i].Latency);
+    }
+
+    free(Data);
+    munmap(Map,lSize);
+
+    return lCalls;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReserveCheckpoint()
+//  Description :      It is used to make room for record at end
+//                      of buffer of checkpoint. Buffer grows by
+//                      doubling.
+//  Input :            Checkpoint writer and bytes needed
+//  Output :           Address where record is to be built
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+char * ReserveCheckpoint(
+                            PCHECKPOINTWRITER writer,   // Checkpoint being written
+                            long long size              // Bytes needed
+                        )
+{
+    if(writer->Length + size > writer->Capacity)
+    {
+        while(writer->Length + size > writer->Capacity)
+        {
+            writer->Capacity = writer->Capacity * 2;
+        }
+
+        writer->Buffer = (char *)realloc(writer->Buffer,writer->Capacity);
+    }
+
+    return writer->Buffer + writer->Length;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SealCheckpoint()
+//  Description :      It is used to add checksum to record built
+//                      at end of buffer and to keep it
+//  Input :            Checkpoint writer
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void SealCheckpoint(
+                        PCHECKPOINTWRITER writer    // Checkpoint being written
+                    )
+{
+    char *ptr = writer->Buffer + writer->Length;
+    CHECKPOINTRECORD rec;
+    int iCovered = 0;
+
+    // Names of earlier record leave it at any offset
+    memcpy(&rec,ptr,sizeof(rec));
+
+    iCovered = sizeof(CHECKPOINTRECORD) - offsetof(CHECKPOINTRECORD,Length) + rec.Length;
+    rec.Check = CalculateCRC32C(ptr + offsetof(CHECKPOINTRECORD,Length),iCovered);
+
+    memcpy(ptr,&rec,sizeof(rec));
+
+    writer->Length = writer->Length + sizeof(CHECKPOINTRECORD) + rec.Length;
+    writer->Records++;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     FlushCheckpoint()
+//  Description :      It is used to write buffer of checkpoint to
+//                      its file. With bandwidth each piece waits
+//                      till bytes written so far are due.
+//  Input :            Checkpoint writer
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void FlushCheckpoint(
+                        PCHECKPOINTWRITER writer    // Checkpoint being written
+                     )
+{
+    struct timespec ts;
+    long long lDone = 0;
+    long long lChunk = 0;
+    long long lDue = 0;
+    long long lNow = 0;
+    ssize_t iRet = 0;
+
+    while((lDone < writer->Length) && (writer->Failed == false))
+    {
+        lChunk = writer->Length - lDone;
+
+        if(writer->Bandwidth > 0)
+        {
+            if(lChunk > 64 * 1024)
+            {
+                lChunk = 64 * 1024;
+            }
+
+            lDue = writer->Start + (long long)(writer->Written * 1e9 / (writer->Bandwidth * 1048576.0));
+            lNow = NanoTime();
+
+            if(lDue > lNow)
+            {
+                ts.tv_sec = (lDue - lNow) / 1000000000LL;
+                ts.tv_nsec = (lDue - lNow) % 1000000000LL;
+                nanosleep(&ts,NULL);
+            }
+        }
+
+        iRet = write(writer->Fd,writer->Buffer + lDone,lChunk);
+
+        if(iRet <= 0)
+        {
+            writer->Failed = true;
+            break;
+        }
+
+        lDone = lDone + iRet;
+        writer->Written = writer->Written + iRet;
+    }
+
+    writer->Length = 0;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     PinBlocks()
+//  Description :      It is used to take dirty blocks of one file
+//                      at the moment of checkpoint. Block in pool
+//                      gets one more share, so writer copies it
+//                      before changing it and it stays as it is
+//                      till it is copied. Blocks of spilled file
+//                      are read from backing file at once, as its
+//                      space may be reused after fault in. Lock
+//                      must be held for write.
+//  Input :            Checkpoint writer, item to fill and file
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void PinBlocks(
+                PCHECKPOINTWRITER writer,   // Checkpoint being written
+                PCHECKPOINTITEM item,       // Filled with pinned blocks
+                PINODE inode                // Changed file
+              )
+{
+    PINODECOLD cold = ColdInode(inode);
+    CHECKPOINTRECORD rec;
+    char *ptr = NULL;
+    long long lBlocks = (inode->ActualFileSize + BLOCKSIZE - 1) / BLOCKSIZE;
+    long long lCapacity = 0;
+    long long lTier = -1;
+    long long i = 0;
+
+    item->InodeNumber = inode->InodeNumber;
+    item->Blocks = NULL;
+    item->Index = NULL;
+    item->Count = 0;
+
+    if(lBlocks > BlockCount(inode))
+    {
+        lBlocks = BlockCount(inode);
+    }
+
+    memset(&rec,0,sizeof(rec));
+    rec.Type = CKPT_BLOCK;
+    rec.InodeNumber = inode->InodeNumber;
+    rec.FileType = REGULARFILE;
+    rec.Length = BLOCKSIZE;
+
+    for(i = 0; i < lBlocks; i++)
+    {
+        if(inode->BlockMap[i] == HOLEBLOCK)
+        {
+            continue;
+        }
+
+        // Backing file holds blocks of spilled file without its holes
+        lTier++;
+
+        if((cold->CheckpointAll == false) &&
+           ((i / 8 >= cold->DirtyBytes) || ((cold->DirtyBlocks[i / 8] & (1 << (i % 8))) == 0)))
+        {
+            continue;
+        }
+
+        if(cold->Spilled == true)
+        {
+            ptr = ReserveCheckpoint(writer,sizeof(rec) + BLOCKSIZE);
+            rec.Value = i;
+            memcpy(ptr,&rec,sizeof(rec));
+
+            if(pread(Tier.Fd,ptr + sizeof(rec),BLOCKSIZE,(cold->TierStart + lTier) * BLOCKSIZE) != BLOCKSIZE)
+            {
+                writer->Failed = true;
+            }
+
+            SealCheckpoint(writer);
+            writer->Blocks++;
+            continue;
+        }
+
+        if(item->Count == lCapacity)
+        {
+            lCapacity = (lCapacity == 0) ? 64 : lCapacity * 2;
+            item->Blocks = (long long *)realloc(item->Blocks,lCapacity * sizeof(long long));
+            item->Index = (long long *)realloc(item->Index,lCapacity * sizeof(long long));
+        }
+
+        item->Blocks[item->Count] = inode->BlockMap[i];
+        item->Index[item->Count] = i;
+        item->Count++;
+
+        Pool.Shares[inode->BlockMap[i]]++;
+        Pool.SharedBlocks++;
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CaptureBlocks()
+//  Description :      It is used to copy pinned blocks of one file
+//                      into checkpoint and to drop their shares.
+//                      Pinned block does not change, so lock is
+//                      held only while one batch is copied. Shares
+//                      are dropped even when checkpoint has failed.
+//  Input :            Checkpoint writer and file
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void CaptureBlocks(
+                    PCHECKPOINTWRITER writer,   // Checkpoint being written
+                    PCHECKPOINTITEM item        // File and its pinned blocks
+                  )
+{
+    CHECKPOINTRECORD rec;
+    char *ptr = NULL;
+    char *data = NULL;
+    long long lFirst = 0;
+    long long lLast = 0;
+    long long i = 0;
+
+    memset(&rec,0,sizeof(rec));
+    rec.Type = CKPT_BLOCK;
+    rec.InodeNumber = item->InodeNumber;
+    rec.FileType = REGULARFILE;
+    rec.Length = BLOCKSIZE;
+
+    for(lFirst = 0; lFirst < item->Count; lFirst = lLast)
+    {
+        lLast = (lFirst + CKPTBATCH < item->Count) ? lFirst + CKPTBATCH : item->Count;
+
+        LockFileSystem(false);
+
+        for(i = lFirst; (i < lLast) && (writer->Failed == false); i++)
+        {
+            ptr = ReserveCheckpoint(writer,sizeof(rec) + BLOCKSIZE);
+            rec.Value = item->Index[i];
+            memcpy(ptr,&rec,sizeof(rec));
+
+            data = GetBlock(item->Blocks[i],CACHE_READ);
+            memcpy(ptr + sizeof(rec),data,BLOCKSIZE);
+            PutBlock(data,false);
+
+            SealCheckpoint(writer);
+            writer->Blocks++;
+        }
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        // Block which file changed or freed meanwhile goes back to pool now
+        LockFileSystem(true);
+
+        for(i = lFirst; i < lLast; i++)
+        {
+            FreeBlock(item->Blocks[i]);
+        }
+
+        pthread_rwlock_unlock(&FileSystemLock);
+
+        FlushCheckpoint(writer);
+    }
+
+    free(item->Blocks);
+    free(item->Index);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WriteCheckpoint()
+//  Description :      It is used to append inodes and blocks
+//                      changed since last checkpoint to checkpoint
+//                      file. Metadata and blocks of all changed
+//                      files are taken at one moment under lock,
+//                      blocks are pinned and copied afterwards in
+//                      batches while writers change own copies.
+//                      First checkpoint into a file writes all
+//                      files.
+//  Input :            Host file or NULL for file of last
+//                      checkpoint and MB per second, 0 for no limit
+//  Output :           Bytes written or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long WriteCheckpoint(
+                            const char *path,   // Checkpoint file of host or NULL
+                            int bandwidth       // MB per second, 0 for no limit
+                         )
+{
+    CHECKPOINTWRITER writer;
+    CHECKPOINTMARK mark;
+    CHECKPOINTRECORD rec;
+    PCHECKPOINTITEM Items = NULL;
+    PINODE inode = NULL;
+    PINODECOLD cold = NULL;
+    PDIRENTRY entry = NULL;
+    char *ptr = NULL;
+    long long lStart = NanoTime();
+    long long lItems = 0;
+    long long lLength = 0;
+    long long lInodes = 0;
+    long long i = 0;
+    bool bFull = false;
+    int fd = 0;
+
+    if(bandwidth < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&Checkpoint.Lock);
+
+    if(path == NULL)
+    {
+        path = Checkpoint.Path;
+    }
+
+    if(path == NULL)
+    {
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    // Changes are kept only on top of earlier complete checkpoints of same file
+    bFull = (Checkpoint.Path == NULL) || (strcmp(Checkpoint.Path,path) != 0) || (Checkpoint.Failed == true);
+
+    fd = open(path,bFull ? (O_WRONLY | O_CREAT | O_TRUNC) : (O_WRONLY | O_APPEND),0644);
+
+    if(fd == -1)
+    {
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    memset(&writer,0,sizeof(writer));
+    writer.Fd = fd;
+    writer.Capacity = CKPTBUFFER;
+    writer.Buffer = (char *)malloc(CKPTBUFFER);
+    writer.Start = lStart;
+    writer.Bandwidth = bandwidth;
+
+    if(bFull == true)
+    {
+        memcpy(writer.Buffer,CKPTMAGIC,CKPTMAGICSIZE);
+        writer.Length = CKPTMAGICSIZE;
+    }
+
+    mark.Magic = CKPT_BEGIN;
+    mark.Records = 0;
+    mark.Sequence = (bFull == true) ? 1 : Checkpoint.Sequence + 1;
+    mark.Time = time(NULL);
+
+    memcpy(writer.Buffer + writer.Length,&mark,sizeof(mark));
+    writer.Length = writer.Length + sizeof(mark);
+
+    LockFileSystem(true);
+
+    // Writes waiting in write behind buffers belong to checkpoint
+    CommitBufferedWrites(NULL,NULL);
+
+    if(bFull == true)
+    {
+        for(inode = head; inode != NULL; inode = NextInode(inode))
+        {
+            if(inode->FileType != 0)
+            {
+                MarkCheckpoint(inode);
+                ColdInode(inode)->CheckpointAll = true;
+            }
+        }
+    }
+
+    Items = (PCHECKPOINTITEM)malloc((Checkpoint.DirtyInodes + 1) * sizeof(CHECKPOINTITEM));
+
+    while(Checkpoint.Dirty != NULL)
+    {
+        inode = Checkpoint.Dirty;
+        cold = ColdInode(inode);
+
+        Checkpoint.Dirty = cold->NextDirty;
+        cold->NextDirty = NULL;
+        cold->CheckpointDirty = false;
+
+        memset(&rec,0,sizeof(rec));
+        rec.Type = CKPT_INODE;
+        rec.InodeNumber = inode->InodeNumber;
+
+        // FIFO and file left without names are not kept, restored
+        // file system has no descriptors to reach them
+        if((inode->FileType == REGULARFILE) && (inode->LinkCount > 0))
+        {
+            for(entry = cold->Entries, lLength = 0; entry != NULL; entry = entry->nextname)
+            {
+                lLength = lLength + strlen(entry->FileName->Text) + 1;
+            }
+
+            rec.FileType = REGULARFILE;
+            rec.Permission = inode->Permission;
+            rec.Value = inode->ActualFileSize;
+            rec.MinSize = cold->MinSize;
+            rec.Length = lLength;
+        }
+
+        ptr = ReserveCheckpoint(&writer,sizeof(rec) + rec.Length);
+        memcpy(ptr,&rec,sizeof(rec));
+        ptr = ptr + sizeof(rec);
+
+        for(entry = cold->Entries; (rec.FileType == REGULARFILE) && (entry != NULL); entry = entry->nextname)
+        {
+            strcpy(ptr,entry->FileName->Text);
+            ptr = ptr + strlen(ptr) + 1;
+        }
+
+        SealCheckpoint(&writer);
+        lInodes++;
+
+        if((rec.FileType == REGULARFILE) && ((cold->CheckpointAll == true) || (cold->DirtyBlocks != NULL)))
+        {
+            PinBlocks(&writer,&Items[lItems],inode);
+
+            if(Items[lItems].Count > 0)
+            {
+                lItems++;
+            }
+        }
+
+        free(cold->DirtyBlocks);
+
+        cold->DirtyBlocks = NULL;
+        cold->DirtyBytes = 0;
+        cold->CheckpointAll = false;
+        cold->MinSize = inode->ActualFileSize;
+    }
+
+    Checkpoint.DirtyInodes = 0;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    FlushCheckpoint(&writer);
+
+    for(i = 0; i < lItems; i++)
+    {
+        CaptureBlocks(&writer,&Items[i]);
+
+        ReportProgress(i + 1,lItems);
+    }
+
+    free(Items);
+
+    mark.Magic = CKPT_END;
+    mark.Records = writer.Records;
+
+    memcpy(ReserveCheckpoint(&writer,sizeof(mark)),&mark,sizeof(mark));
+    writer.Length = writer.Length + sizeof(mark);
+
+    FlushCheckpoint(&writer);
+
+    if((writer.Failed == false) && (fdatasync(fd) != 0))
+    {
+        writer.Failed = true;
+    }
+
+    close(fd);
+    free(writer.Buffer);
+
+    // Changes of this checkpoint are lost, so next one into last file
+    // starts it again with all files
+    if(writer.Failed == true)
+    {
+        Checkpoint.Failed = true;
+
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    Checkpoint.Failed = false;
+
+    // Full checkpoint after failure is written into same file
+    if((bFull == true) && (path != Checkpoint.Path))
+    {
+        free(Checkpoint.Path);
+        Checkpoint.Path = strdup(path);
+    }
+
+    if(bFull == true)
+    {
+        Checkpoint.Full++;
+    }
+
+    Checkpoint.Sequence = mark.Sequence;
+    Checkpoint.Checkpoints++;
+    Checkpoint.LastInodes = lInodes;
+    Checkpoint.LastBlocks = writer.Blocks;
+    Checkpoint.LastBytes = writer.Written;
+    Checkpoint.LastTime = NanoTime() - lStart;
+    Checkpoint.Inodes = Checkpoint.Inodes + lInodes;
+    Checkpoint.Blocks = Checkpoint.Blocks + writer.Blocks;
+    Checkpoint.Bytes = Checkpoint.Bytes + writer.Written;
+
+    pthread_mutex_unlock(&Checkpoint.Lock);
+
+    return writer.Written;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CheckCheckpoint()
+//  Description :      It is used to verify that one checkpoint of
+//                      file is complete and undamaged
+//  Input :            Mapped file, its size, offset of checkpoint
+//                      and its expected sequence
+//  Output :           Offset after checkpoint or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long CheckCheckpoint(
+                            const char *map,        // Mapped checkpoint file
+                            long long size,         // Size of file
+                            long long pos,          // Offset of checkpoint
+                            long long sequence      // Expected sequence
+                         )
+{
+    CHECKPOINTMARK mark;
+    CHECKPOINTRECORD rec;
+    long long lRecords = 0;
+    int iCovered = 0;
+
+    // Records are copied out as names leave them at any offset
+    if(pos + (long long)sizeof(CHECKPOINTMARK) > size)
+    {
+        return -1;
+    }
+
+    memcpy(&mark,map + pos,sizeof(mark));
+
+    if((mark.Magic != CKPT_BEGIN) || (mark.Sequence != sequence))
+    {
+        return -1;
+    }
+
+    pos = pos + sizeof(CHECKPOINTMARK);
+
+    while(true)
+    {
+        if(pos + (long long)sizeof(CHECKPOINTMARK) > size)
+        {
+            return -1;
+        }
+
+        memcpy(&mark,map + pos,sizeof(mark));
+
+        if(mark.Magic == CKPT_END)
+        {
+            break;
+        }
+
+        if(pos + (long long)sizeof(CHECKPOINTRECORD) > size)
+        {
+            return -1;
+        }
+
+        memcpy(&rec,map + pos,sizeof(rec));
+
+        if(((rec.Type != CKPT_INODE) && (rec.Type != CKPT_BLOCK)) ||
+           (pos + (long long)sizeof(CHECKPOINTRECORD) + rec.Length > size) || (rec.InodeNumber < 1) || (rec.InodeNumber > MAXINODE))
+        {
+            return -1;
+        }
+
+        iCovered = sizeof(CHECKPOINTRECORD) - offsetof(CHECKPOINTRECORD,Length) + rec.Length;
+
+        if(CalculateCRC32C(map + pos + offsetof(CHECKPOINTRECORD,Length),iCovered) != rec.Check)
+        {
+            return -1;
+        }
+
+        // Names end with zero byte and block is whole
+        if(((rec.Type == CKPT_INODE) && (rec.Length > 0) && (map[pos + sizeof(CHECKPOINTRECORD) + rec.Length - 1] != '\0')) ||
+           ((rec.Type == CKPT_BLOCK) && ((rec.Length != BLOCKSIZE) || (rec.Value < 0))))
+        {
+            return -1;
+        }
+
+        lRecords++;
+        pos = pos + sizeof(CHECKPOINTRECORD) + rec.Length;
+    }
+
+    if((mark.Records != lRecords) || (mark.Sequence != sequence))
+    {
+        return -1;
+    }
+
+    return pos + sizeof(CHECKPOINTMARK);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RestoreNames()
+//  Description :      It is used to give restored inode exactly
+//                      the names of its record. Name taken from
+//                      other inode of same checkpoint is removed
+//                      there first. Lock must be held for write.
+//  Input :            Inode and names of record
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void RestoreNames(
+                    PINODE inode,           // Restored inode
+                    const char *names,      // Names, each ended by zero byte
+                    long long length        // Bytes of names
+                  )
+{
+    PDIRENTRY entry = NULL;
+    PDIRENTRY next = NULL;
+    const char *name = NULL;
+
+    for(entry = ColdInode(inode)->Entries; entry != NULL; entry = next)
+    {
+        next = entry->nextname;
+
+        for(name = names; name < names + length; name = name + strlen(name) + 1)
+        {
+            if(strcmp(name,entry->FileName->Text) == 0)
+            {
+                break;
+            }
+        }
+
+        if(name >= names + length)
+        {
+            DeleteDirEntry(RemoveDirEntry(entry->FileName->Text));
+        }
+    }
+
+    for(name = names; name < names + length; name = name + strlen(name) + 1)
+    {
+        entry = LookupDirEntry(name);
+
+        if((entry != NULL) && (entry->ptrinode == inode))
+        {
+            continue;
+        }
+
+        if(entry != NULL)
+        {
+            DeleteDirEntry(RemoveDirEntry(name));
+        }
+
+        AddDirEntry(name,inode);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ApplyCheckpoint()
+//  Description :      It is used to apply one verified checkpoint.
+//                      Every inode of checkpoint is held by extra
+//                      reference till all records are applied, so
+//                      name moving between files frees nothing.
+//                      Lock must be held for write.
+//  Input :            Mapped file, offset of first record and
+//                      offset of end mark
+//  Output :           EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ApplyCheckpoint(
+                        const char *map,    // Mapped checkpoint file
+                        long long first,    // Offset of first record
+                        long long end       // Offset of end mark
+                    )
+{
+    CHECKPOINTRECORD rec;
+    CHECKPOINTMARK mark;
+    PPINODE Held = NULL;
+    PINODE inode = NULL;
+    const char *data = NULL;
+    long long lPos = 0;
+    long long lCount = 0;
+    long long lLength = 0;
+    long long i = 0;
+    int iRet = EXECUTE_SUCCESS;
+
+    // Records are copied out as names leave them at any offset
+    memcpy(&mark,map + end,sizeof(mark));
+
+    Held = (PPINODE)malloc((mark.Records + 1) * sizeof(PINODE));
+
+    for(lPos = first; lPos < end; lPos = lPos + sizeof(CHECKPOINTRECORD) + rec.Length)
+    {
+        memcpy(&rec,map + lPos,sizeof(rec));
+
+        if(rec.Type != CKPT_INODE)
+        {
+            continue;
+        }
+
+        while(superobj.ReadyInodes < rec.InodeNumber)
+        {
+            ExtendDILB();
+        }
+
+        inode = &InodeTable[rec.InodeNumber - 1];
+
+        if((inode->FileType == 0) && (rec.FileType == 0))
+        {
+            continue;
+        }
+
+        if(inode->FileType == 0)
+        {
+            ColdInode(inode)->Owner = uareaobj.Quota;
+
+            if(ChargeFile(inode,0,1) != EXECUTE_SUCCESS)
+            {
+                iRet = ERR_QUOTA_EXCEEDED;
+                break;
+            }
+
+            // Names are given by second pass
+            inode->FileSize = 0;
+            inode->ActualFileSize = 0;
+            inode->Blocks = 0;
+            inode->FileType = REGULARFILE;
+            inode->LinkCount = 0;
+            inode->ReferenceCount = 0;
+            inode->Permission = rec.Permission;
+            TouchInode(inode);
+
+            superobj.FreeInodes--;
+        }
+
+        inode->ReferenceCount++;
+        Held[lCount] = inode;
+        lCount++;
+    }
+
+    for(lPos = first; (iRet == EXECUTE_SUCCESS) && (lPos < end); lPos = lPos + sizeof(CHECKPOINTRECORD) + rec.Length)
+    {
+        memcpy(&rec,map + lPos,sizeof(rec));
+        data = map + lPos + sizeof(CHECKPOINTRECORD);
+        inode = &InodeTable[rec.InodeNumber - 1];
+
+        if(inode->FileType == 0)
+        {
+            continue;
+        }
+
+        if(rec.Type == CKPT_INODE)
+        {
+            // Freed file loses its names and goes with its reference
+            RestoreNames(inode,data,rec.Length);
+
+            if(rec.FileType == 0)
+            {
+                continue;
+            }
+
+            inode->Permission = rec.Permission;
+
+            if(rec.MinSize < inode->ActualFileSize)
+            {
+                iRet = ResizeFile(inode,rec.MinSize);
+            }
+
+            if((iRet == EXECUTE_SUCCESS) && (rec.Value != inode->ActualFileSize))
+            {
+                iRet = ResizeFile(inode,rec.Value);
+            }
+        }
+        else
+        {
+            // Block written after size of its file was taken
+            lLength = inode->ActualFileSize - rec.Value * BLOCKSIZE;
+
+            if(lLength > BLOCKSIZE)
+            {
+                lLength = BLOCKSIZE;
+            }
+
+            if(lLength <= 0)
+            {
+                continue;
+            }
+
+            iRet = FillHoles(inode,rec.Value * BLOCKSIZE,lLength);
+
+            if(iRet == EXECUTE_SUCCESS)
+            {
+                CommitWrite(inode,rec.Value * BLOCKSIZE,data,lLength);
+            }
+        }
+    }
+
+    for(i = 0; i < lCount; i++)
+    {
+        ReleaseInode(Held[i]);
+    }
+
+    free(Held);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     RestoreCheckpoint()
+//  Description :      It is used to load file system from all
+//                      complete checkpoints of checkpoint file.
+//                      Incomplete or damaged tail is cut off, so
+//                      later checkpoints are appended after last
+//                      good one.
+//  Input :            Host file and address where bytes of cut
+//                      tail are returned
+//  Output :           Checkpoints applied or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+long long RestoreCheckpoint(
+                                const char *path,       // Checkpoint file of host
+                                long long *discarded    // Bytes of bad tail
+                            )
+{
+    PINODE inode = NULL;
+    PINODECOLD cold = NULL;
+    char *Map = NULL;
+    long long lSize = 0;
+    long long lPos = CKPTMAGICSIZE;
+    long long lEnd = 0;
+    long long lApplied = 0;
+    int iRet = EXECUTE_SUCCESS;
+    int fd = 0;
+
+    if((path == NULL) || (discarded == NULL))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&Checkpoint.Lock);
+
+    if(superobj.FreeInodes != superobj.TotalInodes)
+    {
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    fd = open(path,O_RDWR);
+
+    if(fd == -1)
+    {
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    lSize = lseek(fd,0,SEEK_END);
+
+    if(lSize >= CKPTMAGICSIZE)
+    {
+        Map = (char *)mmap(NULL,lSize,PROT_READ,MAP_PRIVATE,fd,0);
+    }
+
+    if((Map == NULL) || (Map == MAP_FAILED) || (memcmp(Map,CKPTMAGIC,CKPTMAGICSIZE) != 0))
+    {
+        if((Map != NULL) && (Map != MAP_FAILED))
+        {
+            munmap(Map,lSize);
+        }
+
+        close(fd);
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return ERR_INVALID_PARAMETER;
+    }
+
+    LockFileSystem(true);
+
+    // Checkpoint is applied only after all of it is verified
+    while((iRet == EXECUTE_SUCCESS) && ((lEnd = CheckCheckpoint(Map,lSize,lPos,lApplied + 1)) != -1))
+    {
+        iRet = ApplyCheckpoint(Map,lPos + sizeof(CHECKPOINTMARK),lEnd - sizeof(CHECKPOINTMARK));
+
+        lPos = lEnd;
+        lApplied++;
+
+        ReportProgress(lPos,lSize);
+    }
+
+    // Restored state is what file holds, next checkpoint adds to it
+    while(Checkpoint.Dirty != NULL)
+    {
+        inode = Checkpoint.Dirty;
+        cold = ColdInode(inode);
+
+        Checkpoint.Dirty = cold->NextDirty;
+        cold->NextDirty = NULL;
+        cold->CheckpointDirty = false;
+
+        free(cold->DirtyBlocks);
+        cold->DirtyBlocks = NULL;
+        cold->DirtyBytes = 0;
+        cold->CheckpointAll = false;
+        cold->MinSize = inode->ActualFileSize;
+    }
+
+    Checkpoint.DirtyInodes = 0;
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    munmap(Map,lSize);
+
+    *discarded = lSize - lPos;
+
+    if((iRet == EXECUTE_SUCCESS) && (lPos < lSize))
+    {
+        ftruncate(fd,lPos);
+    }
+
+    close(fd);
+
+    free(Checkpoint.Path);
+    Checkpoint.Path = NULL;
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&Checkpoint.Lock);
+        return iRet;
+    }
+
+    Checkpoint.Path = strdup(path);
+    Checkpoint.Sequence = lApplied;
+    Checkpoint.Failed = false;
+
+    pthread_mutex_unlock(&Checkpoint.Lock);
+
+    return lApplied;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayCheckpoint()
+//  Description :      It is used to display result of checkpoint
+//  Input :            Value returned by WriteCheckpoint
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayCheckpoint(
+                        long long ret   // Bytes written or error code
+                      )
+{
+    if(ret == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to open checkpoint file\n");
+    }
+    else if(ret == ERR_INSUFFICIENT_SPACE)
+    {
+        printf("Error : Unable to write checkpoint file, next checkpoint writes all files\n");
+    }
+    else if(ret < 0)
+    {
+        printf("Error : Invalid parameter\n");
+    }
+    else
+    {
+        pthread_mutex_lock(&Checkpoint.Lock);
+
+        printf("Checkpoint %lld : %lld inodes, %lld blocks, %.1f KB written in %.3f ms\n",Checkpoint.Sequence,
+               Checkpoint.LastInodes,Checkpoint.LastBlocks,Checkpoint.LastBytes / 1024.0,Checkpoint.LastTime / 1e6);
+
+        pthread_mutex_unlock(&Checkpoint.Lock);
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     BenchmarkHugePages()
+//  Description :       It is used to compare scans over a large
+//                      file whose chunks are backed by normal pages
+//                      with the same file backed by huge pages.
+//                      Data is accessed through block map of file
+//                      exactly as read path does. Only memory mode
+//                      is measured.
+//  Input :             Size of file in MB
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+volatile long long BenchmarkSink = 0;
+
+int BenchmarkHugePages(
+                        int megabytes   // Size of file in MB
+                      )
+{
+    int iModes[2] = {HUGEPAGE_OFF,HUGEPAGE_TRANSPARENT};
+    int iSavedMode = Pool.HugePageMode;
+    char Name[] = ".benchmark";
+    char *Data = NULL;
+    PINODE inode = NULL;
+    long long *ptr = NULL;
+    long long lSum = 0, lStart = 0, lSeq = 0, lRandom = 0;
+    long long lOffset = 0, lSize = 0, b = 0;
+    unsigned long long x = 88172645463325252ULL;
+    int iAccesses = 1 << 22;
+    int fd = 0, i = 0, iPass = 0, iRet = EXECUTE_SUCCESS;
+
+    // Huge pages back the pool only, not frames of page cache
+    if((megabytes <= 0) || (Cache.ImageFd != -1))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(iSavedMode != HUGEPAGE_OFF)
+    {
+        iModes[1] = iSavedMode;
+    }
+
+    Data = (char *)malloc(1024 * 1024);
+    memset(Data,'M',1024 * 1024);
+
+    printf("Mode\t\tSequential MB/s\tRandom ns/read\tHuge chunks\n");
+
+    for(iPass = 0; iPass < 2; iPass++)
+    {
+        Pool.HugePageMode = iModes[iPass];
+
+        fd = CreateFile(Name,READ + WRITE);
+
+        if(fd < 0)
+        {
+            iRet = fd;
+            break;
+        }
+
+        for(i = 0; i < megabytes; i++)
+        {
+            if(WriteFile(fd,Data,1024 * 1024) < 0)
+            {
+                iRet = ERR_INSUFFICIENT_SPACE;
+                break;
+            }
+        }
+
+        inode = uareaobj.UFDT[fd]->ptrinode;
+        lSize = inode->ActualFileSize;
+
+        // Sequential scan of every 8 bytes of file
+        lStart = NanoTime();
+
+        for(b = 0; (iRet == EXECUTE_SUCCESS) && (b < lSize / BLOCKSIZE); b++)
+        {
+            ptr = (long long *)BlockAddress(inode->BlockMap[b]);
+
+            for(i = 0; i < BLOCKSIZE / (int)sizeof(long long); i++)
+            {
+                lSum = lSum + ptr[i];
+            }
+        }
+
+        lSeq = NanoTime() - lStart;
+
+        // Random 8 byte reads spread over whole file
+        lStart = NanoTime();
+
+        for(i = 0; (iRet == EXECUTE_SUCCESS) && (i < iAccesses); i++)
+        {
+            x = x ^ (x << 13);
+            x = x ^ (x >> 7);
+            x = x ^ (x << 17);
+
+            lOffset = (x % (lSize / sizeof(long long))) * sizeof(long long);
+            lSum = lSum + *(long long *)(BlockAddress(inode->BlockMap[lOffset / BLOCKSIZE]) + (lOffset % BLOCKSIZE));
+        }
+
+        lRandom = NanoTime() - lStart;
+
+        if(iRet == EXECUTE_SUCCESS)
+        {
+            printf("%-12s\t%.0f\t\t%.1f\t\t%d\n",
+                   HugePageModeName(iModes[iPass]),
+                   ((double)lSize / (1024 * 1024)) / ((double)lSeq / 1000000000.0),
+                   (double)lRandom / iAccesses,
+                   Pool.HugeChunks);
+        }
+
+        UnlinkFile(Name);
+        CloseFile(fd);
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    BenchmarkSink = lSum;
+    Pool.HugePageMode = iSavedMode;
+
+    free(Data);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CanSpill()
+//  Description :       It is used to check whether file may be moved
+//                      to backing file. Files held open are hot.
+//  Input :             Inode of file
+//  Output :            true or false
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool CanSpill(
+                PINODE inode    // Inode of file
+             )
+{
+    return ((Tier.Fd != -1) && (inode->FileType == REGULARFILE) && (ColdInode(inode)->Spilled == false) &&
+            (inode->Blocks > 0) && (inode->ReferenceCount == inode->LinkCount));
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SpillFile()
+//  Description :       It is used to move data of file to backing
+//                      file and give its pool blocks and memory back.
+//                      Data is written under read lock so readers
+//                      are not stopped. Block map is switched under
+//                      write lock only if file is not changed.
+//  Input :             Inode of file
+//  Output :            true if file is spilled
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+bool SpillFile(
+                PINODE inode    // Inode of file
+              )
+{
+    PINODECOLD cold = ColdInode(inode);
+    struct iovec Vector[MAXIOVECS];
+    long long *Source = NULL;
+    long long lMapBlocks = 0;
+    long long lCount = 0;
+    long long lChanges = 0;
+    long long lStart = 0;
+    long long i = 0, j = 0, r = 0;
+    ssize_t iWritten = 0;
+    int n = 0;
+    bool bSpilled = false;
+
+    LockFileSystem(true);
+
+    if(CanSpill(inode) == false)
+    {
+        pthread_rwlock_unlock(&FileSystemLock);
+        return false;
+    }
+
+    lMapBlocks = BlockCount(inode);
+    lCount = inode->Blocks;
+    lChanges = cold->Changes;
+    lStart = TierAllocate(lCount);
+
+    // Data blocks in order of file, holes stay in block map
+    Source = (long long *)malloc(lCount * sizeof(long long));
+
+    for(i = 0, j = 0; i < lMapBlocks; i++)
+    {
+        if(inode->BlockMap[i] != HOLEBLOCK)
+        {
+            Source[j] = inode->BlockMap[i];
+            j++;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    LockFileSystem(false);
+
+    for(j = 0; j < lCount; j = j + n)
+    {
+        for(n = 0; (n < MAXIOVECS) && (j + n < lCount); n++)
+        {
+            Vector[n].iov_base = BlockAddress(Source[j + n]);
+            Vector[n].iov_len = BLOCKSIZE;
+            Tier.Checksum[lStart + j + n] = Pool.Checksum[Source[j + n]];
+        }
+
+        iWritten = pwritev(Tier.Fd,Vector,n,(lStart + j) * BLOCKSIZE);
+
+        if(iWritten != (ssize_t)n * BLOCKSIZE)
+        {
+            break;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    LockFileSystem(true);
+
+    bSpilled = ((j >= lCount) && (CanSpill(inode) == true) && (cold->Changes == lChanges) &&
+                (BlockCount(inode) == lMapBlocks) && (inode->Blocks == lCount));
+
+    // Defragmenter may have moved the blocks meanwhile
+    for(i = 0, j = 0; (bSpilled == true) && (i < lMapBlocks); i++)
+    {
+        if(inode->BlockMap[i] != HOLEBLOCK)
+        {
+            bSpilled = (inode->BlockMap[i] == Source[j]);
+            j++;
+        }
+    }
+
+    if(bSpilled == true)
+    {
+        // Memory of each run of blocks goes back to OS, copies still use shared ones
+        for(j = 0; j < lCount; j = r)
+        {
+            r = j + 1;
+
+            if(Pool.Shares[Source[j]] != 0)
+            {
+                continue;
+            }
+
+            while((r < lCount) && (Source[r] == Source[r - 1] + 1) && (Pool.Shares[Source[r]] == 0))
+            {
+                r++;
+            }
+
+            madvise(BlockAddress(Source[j]),(r - j) * BLOCKSIZE,MADV_DONTNEED);
+        }
+
+        for(i = 0, j = 0; i < lMapBlocks; i++)
+        {
+            if(inode->BlockMap[i] != HOLEBLOCK)
+            {
+                FreeBlock(inode->BlockMap[i]);
+                inode->BlockMap[i] = lStart + j;
+                j++;
+            }
+        }
+
+        if(cold->HugeLeft > 0)
+        {
+            ReleaseChunk(cold->HugeNext / CHUNKBLOCKS);
+            cold->HugeNext = -1;
+            cold->HugeLeft = 0;
+        }
+
+        cold->Spilled = true;
+        cold->TierStart = lStart;
+        cold->Changes++;
+
+        Tier.SpilledFiles++;
+        Tier.SpilledBlocks = Tier.SpilledBlocks + lCount;
+        Tier.Spills++;
+        Tier.BlocksOut = Tier.BlocksOut + lCount;
+    }
+    else
+    {
+        TierFree(lStart,lCount);
+        Tier.Retries++;
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    free(Source);
+
+    return bSpilled;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ColdestFile()
+//  Description :       It is used to find file which is not
+//                      accessed for longest time, at least for idle
+//                      time of policy
+//  Input :             Nothing
+//  Output :            Inode of file or NULL
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+PINODE ColdestFile()
+{
+    PINODE temp = NULL;
+    PINODE best = NULL;
+    unsigned int iIdle = 0;
+    unsigned int iBest = 0;
+
+    LockFileSystem(false);
+
+    for(temp = head; temp != NULL; temp = NextInode(temp))
+    {
+        if(CanSpill(temp) == false)
+        {
+            continue;
+        }
+
+        iIdle = __atomic_load_n(&Tier.Clock,__ATOMIC_RELAXED) - __atomic_load_n(&ColdInode(temp)->LastAccess,__ATOMIC_RELAXED);
+
+        if((iIdle >= Tier.Idle) && ((best == NULL) || (iIdle > iBest) || ((iIdle == iBest) && (temp->Blocks > best->Blocks))))
+        {
+            best = temp;
+            iBest = iIdle;
+        }
+    }
+
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    return best;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     TierThread()
+//  Description :       It is used to advance tier clock and to
+//                      spill coldest files when data in pool goes
+//                      above high mark, until it is at low mark
+//  Input :             Not used
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void * TierThread(
+                    void *arg   // Not used
+                 )
+{
+    PINODE victim = NULL;
+    int i = 0;
+
+    (void)arg;
+
+    while(1)
+    {
+        usleep(TIERINTERVAL * 1000);
+
+        __atomic_add_fetch(&Tier.Clock,1,__ATOMIC_RELAXED);
+
+        if((Tier.Enabled == false) || (Pool.UsedBlocks * BLOCKSIZE <= Tier.High))
+        {
+            continue;
+        }
+
+        for(i = 0; (i < TIERBATCH) && (Tier.Enabled == true) && (Pool.UsedBlocks * BLOCKSIZE > Tier.Low); i++)
+        {
+            victim = ColdestFile();
+
+            if((victim == NULL) || (SpillFile(victim) == false))
+            {
+                break;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     SetTierPolicy()
+//  Description :       It is used to enable tiering with new marks.
+//                      Backing file is created in current directory
+//                      and removed from it at once, so it goes away
+//                      with the process.
+//  Input :             High and low marks in MB and idle seconds
+//  Output :            EXECUTE_SUCCESS or error code
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int SetTierPolicy(
+                    int high,       // Spilling starts above this MB
+                    int low,        // Spilling stops at this MB
+                    int idle        // Seconds without access
+                 )
+{
+    char Name[] = TIERFILE;
+    int fd = 0;
+
+    // Image is already disk backed with bounded cache
+    if((Cache.ImageFd != -1) || (high <= 0) || (low < 0) || (low > high) || (idle < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(Tier.Fd == -1)
+    {
+        fd = mkstemp(Name);
+
+        if(fd == -1)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        unlink(Name);
+
+        Tier.Fd = fd;
+
+        pthread_create(&TierThreadId,NULL,TierThread,NULL);
+        pthread_detach(TierThreadId);
+    }
+
+    Tier.High = (long long)high * 1024 * 1024;
+    Tier.Low = (long long)low * 1024 * 1024;
+    Tier.Idle = ((long long)idle * 1000) / TIERINTERVAL;
+    Tier.Enabled = true;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayTier()
+//  Description :       It is used to display policy of tiering and
+//                      counters of migrations
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayTier()
+{
+    LockFileSystem(false);
+
+    if(Tier.Enabled == true)
+    {
+        printf("Tiering             : on, spill above %lld MB down to %lld MB, idle %u s\n",Tier.High / (1024 * 1024),
+               Tier.Low / (1024 * 1024),(unsigned int)(((long long)Tier.Idle * TIERINTERVAL) / 1000));
+    }
+    else
+    {
+        printf("Tiering             : off\n");
+    }
+
+    printf("Spilled files       : %lld (%lld blocks, backing file %lld blocks)\n",Tier.SpilledFiles,Tier.SpilledBlocks,Tier.End);
+    printf("Tier migrations     : %lld out (%lld blocks), %lld in (%lld blocks), %lld retries\n",Tier.Spills,Tier.BlocksOut,
+           Tier.Faults,Tier.BlocksIn,Tier.Retries);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayQuota()
+//  Description :       It is used to display usage and limits of
+//                      quota after reconciling per CPU counters
+//  Input :             Quota
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayQuota(
+                    PQUOTA quota    // Quota
+                 )
+{
+    pthread_mutex_lock(&quota->Lock);
+
+    FoldQuota(quota);
+
+    printf("%-12s quota    : %lld bytes",quota->Name,quota->Bytes);
+
+    if(quota->ByteLimit != 0)
+    {
+        printf(" of %lld",quota->ByteLimit);
+    }
+
+    printf(", %lld inodes",quota->Inodes);
+
+    if(quota->InodeLimit != 0)
+    {
+        printf(" of %lld",quota->InodeLimit);
+    }
+
+    printf(", %lld refused\n",quota->Refused);
+
+    pthread_mutex_unlock(&quota->Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     Defragment()
+//  Description :       It is used to make all small files
+//                      contiguous now
+//  Input :             Nothing
+//  Output :            Number of files moved
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int Defragment()
+{
+    int iFiles = 0;
+    int iLimit = 0;
+
+    SyncBufferedWrites();
+
+    // Each file needs one move, lost moves are retried few times
+    for(iLimit = 2 * MAXINODE; (iLimit > 0) && (DefragmentStep() == true); iLimit--)
+    {
+        iFiles++;
+        ReportProgress(iFiles,0);
+    }
+
+    return iFiles;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayFragmentation()
+//  Description :       It is used to display fragmentation of
+//                      files and of free space of small region
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayFragmentation()
+{
+    PINODE temp = NULL;
+    long long lExtents = 0;
+    long long lFileExtents = 0;
+    long long lBlocks = 0;
+    long long lLargest = 0;
+    int iFiles = 0;
+    int iFragmented = 0;
+    int i = 0;
+
+    LockFileSystem(false);
+
+    for(temp = head; temp != NULL; temp = NextInode(temp))
+    {
+        if((temp->FileType != REGULARFILE) || (temp->Blocks == 0) || (ColdInode(temp)->Spilled == true))
+        {
+            continue;
+        }
+
+        lFileExtents = CountExtents(temp);
+
+        iFiles++;
+        iFragmented = iFragmented + (lFileExtents > 1);
+        lExtents = lExtents + lFileExtents;
+        lBlocks = lBlocks + temp->Blocks;
+    }
+
+    printf("Fragmented files    : %d of %d (%lld extents for %lld blocks)\n",iFragmented,iFiles,lExtents,lBlocks);
+    printf("Free buddies        :");
+
+    for(i = 0; i < BUDDYORDERS; i++)
+    {
+        printf(" %d:%lld",1 << i,Pool.FreeCount[i]);
+
+        if(Pool.FreeCount[i] != 0)
+        {
+            lLargest = 1LL << i;
+        }
+    }
+
+    printf("\n");
+    // Free space outside whole free chunks is fragmented
+    printf("Free small blocks   : %lld, largest extent %lld (%.1f%% fragmented)\n",Pool.FreeSmall,lLargest,
+           (Pool.FreeSmall == 0) ? 0.0 : 100.0 * (Pool.FreeSmall - Pool.FreeCount[BUDDYORDERS - 1] * CHUNKBLOCKS) / Pool.FreeSmall);
+    printf("Defragmenter        : %s, %lld files, %lld blocks moved, %lld retries\n",Pool.DefragEnabled ? "on" : "off",
+           Pool.DefragFiles,Pool.DefragBlocks,Pool.DefragRetries);
+
+    pthread_rwlock_unlock(&FileSystemLock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     CompareLockWait
+//  Description :       It is used by qsort to order inodes by time
+//                      spent waiting for their locks, longest first
+//  Input :             Addresses of two inodes
+//  Output :            Negative, zero or positive
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int CompareLockWait(
+                    const void *first,  // First inode
+                    const void *second  // Second inode
+                   )
+{
+    long long lFirst = ColdInode(*(const PINODE *)first)->Locking->WaitTime;
+    long long lSecond = ColdInode(*(const PINODE *)second)->Locking->WaitTime;
+
+    return (lFirst < lSecond) - (lFirst > lSecond);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayLocks()
+//  Description :       It is used to display lock counters and wait
+//                      histogram of each locked file, files with
+//                      longest waits first
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayLocks()
+{
+    PINODE *Files = NULL;
+    PLOCKSTATE state = NULL;
+    PFILELOCK temp = NULL;
+    long long lWaits = 0;
+    int iCount = 0;
+    int iHeld = 0;
+    int i = 0;
+    int j = 0;
+
+    LockFileSystem(false);
+    pthread_mutex_lock(&Locks.Mutex);
+
+    Files = (PINODE *)malloc((superobj.ReadyInodes + 1) * sizeof(PINODE));
+
+    for(i = 0; i < superobj.ReadyInodes; i++)
+    {
+        if(ColdInode(&InodeTable[i])->Locking != NULL)
+        {
+            Files[iCount++] = &InodeTable[i];
+        }
+    }
+
+    qsort(Files,iCount,sizeof(PINODE),CompareLockWait);
+
+    printf("Inode\tName\t\tHeld\tTaken\tWaited\tRefused\tTimeout\tDeadlck\tMean us\tMax us\n");
+
+    for(i = 0; i < iCount; i++)
+    {
+        state = ColdInode(Files[i])->Locking;
+        iHeld = 0;
+        lWaits = 0;
+
+        for(temp = state->Held; temp != NULL; temp = temp->next)
+        {
+            iHeld++;
+        }
+
+        for(j = 0; j < LOCKBUCKETS; j++)
+        {
+            lWaits += state->Histogram[j];
+        }
+
+        printf("%d\t%-15s\t%d\t%lld\t%lld\t%lld\t%lld\t%lld\t%lld\t%lld\n",Files[i]->InodeNumber,
+               (ColdInode(Files[i])->Entries != NULL) ? ColdInode(Files[i])->Entries->FileName->Text : "(unlinked)",
+               iHeld,state->Acquired,lWaits,state->Refused,state->Timeouts,state->Deadlocks,
+               (lWaits > 0) ? state->WaitTime / lWaits / 1000 : 0,state->MaxWait / 1000);
+
+        if(lWaits > 0)
+        {
+            printf("\twaits <10us:%lld <100us:%lld <1ms:%lld <10ms:%lld <100ms:%lld <1s:%lld <10s:%lld more:%lld\n",
+                   state->Histogram[0],state->Histogram[1],state->Histogram[2],state->Histogram[3],
+                   state->Histogram[4],state->Histogram[5],state->Histogram[6],state->Histogram[7]);
+        }
+    }
+
+    pthread_mutex_unlock(&Locks.Mutex);
+    pthread_rwlock_unlock(&FileSystemLock);
+
+    free(Files);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     LockMode
+//  Description :       It is used to read mode of lock given as sh,
+//                      ex or un with optional /ms, /0 does not wait
+//  Input :             Text of mode, address of timeout
+//  Output :            Mode or -1
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int LockMode(
+                const char *text,   // Such as ex/500
+                int *timeout        // Filled with milliseconds
+            )
+{
+    const char *wait = strchr(text,'/');
+    int iLength = (wait == NULL) ? strlen(text) : wait - text;
+
+    *timeout = (wait == NULL) ? LOCK_FOREVER : atoi(wait + 1);
+
+    if((wait != NULL) && ((wait[1] < '0') || (wait[1] > '9')))
+    {
+        return -1;
+    }
+
+    if((iLength == 2) && (strncmp(text,"sh",2) == 0))
+    {
+        return LOCK_SHARED;
+    }
+    else if((iLength == 2) && (strncmp(text,"ex",2) == 0))
+    {
+        return LOCK_EXCLUSIVE;
+    }
+    else if((iLength == 2) && (strncmp(text,"un",2) == 0))
+    {
+        return LOCK_RELEASE;
+    }
+
+    return -1;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayLockError
+//  Description :       It is used to display result of lock request
+//  Input :             Result of LockFile
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayLockError(
+                        int iRet    // Result of LockFile
+                      )
+{
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Lock is updated\n");
+    }
+    else if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid parameter, please refer man page\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : File is not opened\n");
+    }
+    else if(iRet == ERR_WOULD_BLOCK)
+    {
+        printf("Error : File is locked by other descriptor\n");
+    }
+    else if(iRet == ERR_TIMED_OUT)
+    {
+        printf("Error : Lock is not released in given time\n");
+    }
+    else if(iRet == ERR_DEADLOCK)
+    {
+        printf("Error : Waiting would deadlock\n");
+    }
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayStatistics()
+//  Description :       It is used to display statistical
+//                      information of file system
+//  Input :             Nothing
+//  Output :            Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayStatistics()
+{
+    int iRate = 0;
+
+    printf("-----------------------------------------------\n");
+    printf("------- Marvellous CVFS Statistics ------------\n");
+    printf("-----------------------------------------------\n");
+
+    printf("Total inodes        : %d\n",superobj.TotalInodes);
+    printf("Free inodes         : %d\n",superobj.FreeInodes);
+    printf("Initialised inodes  : %d\n",superobj.ReadyInodes);
+    printf("Inode size          : %d bytes hot, %d bytes cold\n",(int)sizeof(INODE),(int)sizeof(INODECOLD));
+    printf("Names               : %d in %lld bytes of %lld chunks\n",Names.Names,Names.Bytes,Names.Chunks);
+    printf("Listing index       : %lld names, %lld sizes\n",NameIndex.Count,SizeIndex.Count);
+    printf("Block size          : %d\n",BLOCKSIZE);
+    printf("CRC32C              : %s\n",CRC32CHardware ? "hardware (SSE4.2)" : "software");
+    printf("Search              : %s\n",(SearchLevel == 2) ? "AVX2" : ((SearchLevel == 1) ? "SSE2" : "scalar"));
+    iRate = __atomic_load_n(&superobj.ScrubRate,__ATOMIC_RELAXED);
+
+    printf("Scrub rate          : %d blocks/sec%s\n",iRate,(iRate == 0) ? " (paused)" : "");
+    printf("Scrub passes        : %d\n",__atomic_load_n(&superobj.ScrubPasses,__ATOMIC_RELAXED));
+    printf("Scrubbed blocks     : %lld\n",__atomic_load_n(&superobj.ScrubbedBlocks,__ATOMIC_RELAXED));
+    printf("Checksum errors     : %lld\n",superobj.ChecksumErrors);
+
+    if(superobj.ChecksumErrors != 0)
+    {
+        printf("Last bad block      : inode %d block %lld\n",superobj.LastBadInode,superobj.LastBadBlock);
+    }
+
+    printf("Pool blocks         : %lld used of %lld\n",Pool.UsedBlocks,Pool.TotalBlocks);
+    printf("Shared blocks       : %lld shares by %lld copies, %lld copied on write\n",Pool.SharedBlocks,Pool.Copies,Pool.CopiedOnWrite);
+    printf("Huge page mode      : %s\n",HugePageModeName(Pool.HugePageMode));
+    printf("Huge page chunks    : %d\n",Pool.HugeChunks);
+
+    DisplayFragmentation();
+    printf("Write calls         : %lld (%lld commits to blocks)\n",superobj.WriteCalls,superobj.WriteCommits);
+    printf("Read calls          : %lld\n",__atomic_load_n(&superobj.ReadCalls,__ATOMIC_RELAXED));
+    printf("Mapped view syncs   : %lld (%lld changed blocks written)\n",superobj.MapSyncs,superobj.MapDirtyBlocks);
+    printf("File locks          : %lld taken, %lld contended, %lld refused, %lld timed out, %lld deadlocks\n",
+           Locks.Acquired,Locks.Contended,Locks.Refused,Locks.Timeouts,Locks.Deadlocks);
+    printf("Background jobs     : %lld finished on %d threads\n",Jobs.Completed,Jobs.Threads);
+    printf("Checkpoints         : %lld (%lld full), %lld inodes, %lld blocks, %.1f MB written\n",
+           Checkpoint.Checkpoints,Checkpoint.Full,Checkpoint.Inodes,Checkpoint.Blocks,Checkpoint.Bytes / 1048576.0);
+    printf("Dirty inodes        : %lld since last checkpoint%s\n",Checkpoint.DirtyInodes,
+           (Checkpoint.Failed == true) ? ", last write failed so next one writes all files" : "");
+    DisplayEvents();
+
+    DisplayQuota(uareaobj.Quota);
+    DisplayQuota(&DirectoryQuota);
+
+    if(Cache.ImageFd == -1)
+    {
+        DisplayTier();
+    }
+
+    if(Cache.ImageFd == -1)
+    {
+        printf("Backing store       : memory\n");
+    }
+    else
+    {
+        pthread_mutex_lock(&CacheLock);
+
+        printf("Backing store       : image %s\n",Cache.ImageName);
+        printf("Cache budget        : %d MB (%d frames used)\n",Cache.Limit / ((1024 * 1024) / BLOCKSIZE),Cache.InUse);
+        printf("Cache queues        : A1in %d, Am %d, A1out %d\n",Cache.A1inSize,Cache.AmSize,Cache.GhostSize);
+        printf("Cache hits          : %lld (%.1f%%)\n",Cache.Hits,
+               (Cache.Hits + Cache.Misses == 0) ? 0.0 : (100.0 * Cache.Hits) / (Cache.Hits + Cache.Misses));
+        printf("Cache misses        : %lld\n",Cache.Misses);
+        printf("Cache evictions     : %lld\n",Cache.Evictions);
+        printf("Image reads         : %lld calls for %lld blocks (%lld prefetched)\n",Cache.ReadOps,Cache.ReadBlocks,Cache.Prefetched);
+        printf("Image writes        : %lld calls for %lld blocks\n",Cache.WriteOps,Cache.Writebacks);
+
+        pthread_mutex_unlock(&CacheLock);
+    }
+
+    printf("-----------------------------------------------\n");
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ReportJobs()
+//  Description :      It is used to display and forget jobs which
+//                      are done
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void ReportJobs()
+{
+    PJOB *pprev = &Jobs.Jobs;
+    PJOB temp = NULL;
+
+    pthread_mutex_lock(&Jobs.Lock);
+
+    while(*pprev != NULL)
+    {
+        temp = *pprev;
+
+        if(temp->State != JOB_DONE)
+        {
+            pprev = &temp->next;
+            continue;
+        }
+
+        printf("[%d] Done\t%.3f s\t%s\n",temp->Id,(temp->End - temp->Start) / 1e9,temp->Command);
+
+        *pprev = temp->next;
+        free(temp);
+    }
+
+    pthread_mutex_unlock(&Jobs.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     DisplayJobs()
+//  Description :      It is used to display state, run time and
+//                      progress of background jobs
+//  Input :            Nothing
+//  Output :           Nothing
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+void DisplayJobs()
+{
+    PJOB temp = NULL;
+    long long lNow = NanoTime();
+    long long lDone = 0;
+    long long lTotal = 0;
+    const char *State[] = {"Queued","Running","Done"};
+
+    pthread_mutex_lock(&Jobs.Lock);
+
+    for(temp = Jobs.Jobs; temp != NULL; temp = temp->next)
+    {
+        lDone = __atomic_load_n(&temp->Done,__ATOMIC_RELAXED);
+        lTotal = __atomic_load_n(&temp->Total,__ATOMIC_RELAXED);
+
+        printf("[%d] %s\t%.3f s\t",temp->Id,State[temp->State],
+               (temp->State == JOB_QUEUED) ? 0.0 : (((temp->State == JOB_DONE) ? temp->End : lNow) - temp->Start) / 1e9);
+
+        if((temp->State == JOB_RUNNING) && (lTotal > 0))
+        {
+            printf("%lld%%\t",lDone * 100 / lTotal);
+        }
+        else if((temp->State == JOB_RUNNING) && (lDone > 0))
+        {
+            printf("%lld done\t",lDone);
+        }
+        else
+        {
+            printf("\t");
+        }
+
+        printf("%s\n",temp->Command);
+    }
+
+    pthread_mutex_unlock(&Jobs.Lock);
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     WaitJobs
+//  Description :      It is used to sleep till background job, or
+//                      all of them, is done
+//  Input :            Job id, 0 for all jobs
+//  Output :           Jobs waited for or ERR_INVALID_PARAMETER
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int WaitJobs(
+                int id      // Job id, 0 for all
+            )
+{
+    PJOB temp = NULL;
+    bool bFound = false;
+    bool bRunning = true;
+    int iWaited = 0;
+
+    pthread_mutex_lock(&Jobs.Lock);
+
+    while(bRunning == true)
+    {
+        bRunning = false;
+        iWaited = 0;
+
+        for(temp = Jobs.Jobs; temp != NULL; temp = temp->next)
+        {
+            if((id != 0) && (temp->Id != id))
+            {
+                continue;
+            }
+
+            bFound = true;
+            iWaited++;
+            bRunning = bRunning || (temp->State != JOB_DONE);
+        }
+
+        if(bRunning == true)
+        {
+            pthread_cond_wait(&Jobs.Finished,&Jobs.Lock);
+        }
+    }
+
+    pthread_mutex_unlock(&Jobs.Lock);
+
+    return ((id != 0) && (bFound == false)) ? ERR_INVALID_PARAMETER : iWaited;
+}
+
+//////////////////////////////////////////////////////////
+//
+//  Function Name :     ShellCommand
+//  Description :      It is used to execute one command line of
+//                      shell. Runs in shell or in thread of job.
+//  Input :            Command line
+//  Output :           EXECUTE_SUCCESS or SHELL_EXIT
+//  Author :            Shravani Kishor Darandale
+//  Date :              19/10/2026
+//
+//////////////////////////////////////////////////////////
+
+int ShellCommand(
+                    char *str       // Command line
+                )
+{
+    char Command[5][MAXCOMMANDLINE] = {{'\0'}};
+    int iCount = 0;
+    int iRet = 0;
+    long long lRet = 0;
+    long long lFirst = 0;
+    long long lLast = 0;
+    int fd = 0;
+    char InputBuffer[MAXFILESIZE] = {'\0'};
+    char *EmptyBuffer = NULL;
+    char *ptrView = NULL;
+
+    // Each job thread continues its own listing
+    static __thread LISTCURSOR Listing;
+    static __thread int iPageSize = 0;
+    INGESTJOB Ingest;
+
+
+    iCount = sscanf(str,"%s %s %s %s %s",Command[0],Command[1],Command[2],Command[3], Command[4]);
+
+    if(iCount == 1)
+    {
+        // Marvellous CVFS : > exit
+        if(strcmp("exit",Command[0]) == 0)
+        {
+            // Running jobs still use the file system
+            if(WaitJobs(0) > 0)
+            {
+                ReportJobs();
+            }
+
+            printf("Thank you for using Marvellous CVFS\n");
+            printf("Deallocating all the allocated resources\n");
+
+            if(uareaobj.Transaction != NULL)
+            {
+                AbortTransaction();
+                printf("Started batch is discarded\n");
+            }
+
+            SyncBufferedWrites();
+            FlushCache();
+
+            // Trace file gets its last records
+            StopTrace();
+
+            return SHELL_EXIT;
+        }
+        // Marvellous CVFS : > ls
+        else if(strcmp("ls",Command[0]) == 0)
+        {
+            OpenListing(&Listing,LIST_NAME);
+            LsFile(&Listing,-1);
+        }
+        // Marvellous CVFS : > help
+        else if(strcmp("help",Command[0]) == 0)
+        {
+            DisplayHelp();
+        }
+        // Marvellous CVFS : > clear
+        else if(strcmp("clear",Command[0]) == 0)
+        {
+            #ifdef _WIN32
+                system("cls");
+            #else
+                system("clear");
+            #endif
+        }
+        // Marvellous CVFS : > stat
+        else if(strcmp("stat",Command[0]) == 0)
+        {
+            DisplayStatistics();
+        }
+        // Marvellous CVFS : > lockstat
+        else if(strcmp("lockstat",Command[0]) == 0)
+        {
+            DisplayLocks();
+        }
+        // Marvellous CVFS : > events
+        else if(strcmp("events",Command[0]) == 0)
+        {
+            DisplayEvents();
+        }
+        // Marvellous CVFS : > jobs
+        else if(strcmp("jobs",Command[0]) == 0)
+        {
+            DisplayJobs();
+        }
+        // Marvellous CVFS : > wait
+        else if(strcmp("wait",Command[0]) == 0)
+        {
+            WaitJobs(0);
+            ReportJobs();
+        }
+        // Marvellous CVFS : > defrag
+        else if(strcmp("defrag",Command[0]) == 0)
+        {
+            printf("%d files made contiguous\n",Defragment());
+        }
+        // Marvellous CVFS : > begin
+        else if(strcmp("begin",Command[0]) == 0)
+        {
+            if(BeginTransaction() == ERR_TRANSACTION)
+            {
+                printf("Error : Batch is already started\n");
+            }
+            else
+            {
+                printf("Batch is started, creat, append and unlink are staged\n");
+            }
+        }
+        // Marvellous CVFS : > commit
+        else if(strcmp("commit",Command[0]) == 0)
+        {
+            iRet = CommitTransaction();
+
+            if(iRet == ERR_TRANSACTION)
+            {
+                printf("Error : There is no started batch\n");
+            }
+            else if(iRet < 0)
+            {
+                printf("Error : Batch is not applied as one of its operations failed (%d)\n",iRet);
+            }
+            else
+            {
+                printf("Batch of %d operations is applied\n",iRet);
+
+                // Checkpoint file is log of batch, restore takes all of it or none
+                lRet = WriteCheckpoint(NULL,0);
+
+                if(lRet != ERR_FILE_NOT_EXIST)
+                {
+                    DisplayCheckpoint(lRet);
+                }
+            }
+        }
+        // Marvellous CVFS : > abort
+        else if(strcmp("abort",Command[0]) == 0)
+        {
+            if(AbortTransaction() == ERR_TRANSACTION)
+            {
+                printf("Error : There is no started batch\n");
+            }
+            else
+            {
+                printf("Batch is discarded\n");
+            }
+        }
+        // Marvellous CVFS : > sync
+        else if(strcmp("sync",Command[0]) == 0)
+        {
+            SyncBufferedWrites();
+            iRet = FlushCache();
+
+            if(Cache.ImageFd != -1)
+            {
+                fdatasync(Cache.ImageFd);
+            }
+
+            printf("%d dirty blocks written to image\n",iRet);
+
+            lRet = WriteCheckpoint(NULL,0);
+
+            if(lRet != ERR_FILE_NOT_EXIST)
+            {
+                DisplayCheckpoint(lRet);
+            }
+        }
+    } // End of else if 1
+    else if(iCount == 2)
+    {
+        // Marvellous CVFS : > man ls
+        if(strcmp("man",Command[0]) == 0)
+        {
+            ManPageDisplay(Command[1]);
+        }
+
+        // Marvellous CVFS : > wait 2
+        else if(strcmp("wait",Command[0]) == 0)
+        {
+            if(WaitJobs(atoi(Command[1])) == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : There is no such job\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            ReportJobs();
+        }
+
+        // Marvellous CVFS : > ls next
+        else if((strcmp("ls",Command[0]) == 0) && (strcmp("next",Command[1]) == 0))
+        {
+            if(Listing.Started == false || Listing.Done == true)
+            {
+                printf("Error : There is no listing to continue\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            LsFile(&Listing,iPageSize);
+        }
+
+        // Marvellous CVFS : > ls size
+        else if(strcmp("ls",Command[0]) == 0)
+        {
+            if(ListOrder(Command[1]) == -1)
+            {
+                printf("Error : Order must be name, size or inode\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            OpenListing(&Listing,ListOrder(Command[1]));
+            LsFile(&Listing,-1);
+        }
+
+        // Marvellous CVFS : > unlink Demo.txt
+        else if(strcmp("unlink",Command[0]) == 0)
+        {
+           // Marvellous CVFS : > unlink file_*
+           if(strpbrk(Command[1],"*?[") != NULL)
+           {
+            if(uareaobj.Transaction != NULL)
+            {
+             printf("Error : Bulk commands can not be part of batch\n");
+            }
+            else
+            {
+             printf("%lld files gets successfully deleted\n",UnlinkMatching(Command[1]));
+            }
+            return EXECUTE_SUCCESS;
+           }
+
+           if(uareaobj.Transaction != NULL)
+           {
+            iRet = StageUnlink(Command[1]);
+
+            if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file once staged operations are applied\n");
+            }
+            else
+            {
+                printf("%s\n",(iRet == EXECUTE_SUCCESS) ? "Unlink is staged" : "Error : Invalid parameter");
+            }
+            return EXECUTE_SUCCESS;
+           }
+
+           iRet = UnlinkFile(Command[1]);
+
+           if (iRet == ERR_INVALID_PARAMETER)
+           {
+            printf("erroe : Invalid paramenter\n");
+           }
+
+           if(iRet == ERR_FILE_NOT_EXIST)
+           {
+            printf("Unable to delete file\n");
+           }
+
+           if(iRet == EXECUTE_SUCCESS)
+           {
+            printf("File gets successfully deleted\n");
+           }
+        }
+
+        // Marvellous CVFS : > mkfifo Pipe
+        else if(strcmp("mkfifo",Command[0]) == 0)
+        {
+            iRet = MakeFifo(Command[1]);
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(iRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File is already present\n");
+            }
+            else if(iRet == ERR_NO_INODES)
+            {
+                printf("Error : There is no inode\n");
+            }
+            else if(iRet == ERR_INSUFFICIENT_SPACE)
+            {
+                printf("Error : Unable to allocate ring buffer\n");
+            }
+            else if(iRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Memory or inode quota is used up\n");
+            }
+            else
+            {
+                printf("FIFO gets successfully created\n");
+            }
+        }
+
+        // Marvellous CVFS : > append Demo.txt
+        else if(strcmp("append",Command[0]) == 0)
+        {
+            printf("Enter the data that you want to append : \n");
+            fgets(InputBuffer,MAXFILESIZE,stdin);
+
+            if(uareaobj.Transaction != NULL)
+            {
+                iRet = StageWrite(Command[1],InputBuffer,strlen(InputBuffer)-1);
+
+                if(iRet == ERR_FILE_NOT_EXIST)
+                {
+                    printf("Error : There is no such file once staged operations are applied\n");
+                }
+                else
+                {
+                    printf("%s\n",(iRet == EXECUTE_SUCCESS) ? "Append is staged" : "Error : Invalid parameter");
+                }
+                return EXECUTE_SUCCESS;
+            }
+
+            iRet = OpenFile(Command[1],WRITE + APPEND);
+
+            if(iRet >= 0)
+            {
+                lRet = WriteFile(iRet,InputBuffer,strlen(InputBuffer)-1);
+                CloseFile(iRet);
+                iRet = (int)lRet;
+            }
+
+            if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet < 0)
+            {
+                printf("Error : Unable to append the data (%d)\n",iRet);
+            }
+            else
+            {
+                printf("%d bytes successfully appended\n",iRet);
+            }
+        }
+
+        // Marvellous CVFS : > mmap 3
+        else if(strcmp("mmap",Command[0]) == 0)
+        {
+            iRet = MapFile(atoi(Command[1]),0,0,&ptrView);
+
+            if(iRet == EXECUTE_SUCCESS)
+            {
+                printf("File gets successfully mapped, %lld bytes\n",uareaobj.UFDT[atoi(Command[1])]->ViewLength);
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such opened file\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet == ERR_INSUFFICIENT_DATA)
+            {
+                printf("Error : Range is not inside the file\n");
+            }
+            else
+            {
+                printf("Error : Unable to map the file (%d)\n",iRet);
+            }
+        }
+
+        // Marvellous CVFS : > msync 3
+        else if((strcmp("msync",Command[0]) == 0) || (strcmp("munmap",Command[0]) == 0))
+        {
+            if(strcmp("msync",Command[0]) == 0)
+            {
+                lRet = SyncMap(atoi(Command[1]));
+            }
+            else
+            {
+                lRet = UnmapFile(atoi(Command[1]));
+            }
+
+            if(lRet == ERR_FILE_NOT_EXIST || lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : There is no such mapped file\n");
+            }
+            else if(lRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Memory quota is used up, view keeps changes\n");
+            }
+            else if(lRet < 0)
+            {
+                printf("Error : Unable to write changes (%lld)\n",lRet);
+            }
+            else
+            {
+                printf("%lld changed blocks written to file\n",lRet);
+            }
+        }
+
+        // Marvellous CVFS : > close 3
+        else if(strcmp("close",Command[0]) == 0)
+        {
+            iRet = CloseFile(atoi(Command[1]));
+
+            if(iRet == EXECUTE_SUCCESS)
+            {
+                printf("File gets successfully closed\n");
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST || iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : There is no such opened file\n");
+            }
+            else
+            {
+                printf("Error : Unable to write changes of mapped view (%d), file stays open\n",iRet);
+            }
+        }
+     
+        //Marvellous CVFS : > write 2
+        else if(strcmp("write",Command[0]) == 0)
+        {
+          printf("Enter the data that you want to write : \n");
+          fgets(InputBuffer,MAXFILESIZE,stdin);
+
+          printf("File descriptor: %d\n",atoi(Command[1]));
+          printf("Data that we want to write : %s\n",InputBuffer);
+          printf("Number of bytes that we want to write: %d\n",(int)strlen(InputBuffer)-1);
+
+          iRet = WriteFile(atoi(Command[1]),InputBuffer,strlen(InputBuffer)-1);
+
+          if(iRet  == ERR_INVALID_PARAMETER)
+          {
+            printf("Error\n");
+          }
+
+          else if(iRet == ERR_FILE_NOT_EXIST)
+          {
+            printf("ERROR : no file\n");
+          }
+           else if(iRet == ERR_PERMISSION_DENIED)
+          {
+            printf("ERROR : unable to write\n");
+          }
+           else if(iRet == ERR_INSUFFICIENT_SPACE)
+          {
+            printf("ERROR : unable to write as there is no space\n");
+          }
+          else if(iRet == ERR_QUOTA_EXCEEDED)
+          {
+            printf("ERROR : unable to write as memory quota is used up\n");
+          }
+          else if(iRet == ERR_WOULD_BLOCK)
+          {
+            printf("ERROR : FIFO is full\n");
+          }
+          else if(iRet == ERR_BROKEN_PIPE)
+          {
+            printf("ERROR : FIFO is full and has no reader\n");
+          }
+          else if(iRet == ERR_IO)
+          {
+            printf("ERROR : unable to bring file back from backing file\n");
+          }
+          else
+          {
+            printf("%d bytes successfully written\n",iRet);
+          }
+        }
+
+        // Marvellous CVFS : > grep Marvellous
+        else if(strcmp("grep",Command[0]) == 0)
+        {
+            iRet = GrepFile(Command[1]);
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else
+            {
+                printf("Total %d matches found\n",iRet);
+            }
+        }
+
+        // Marvellous CVFS : > hugepage transparent
+        else if(strcmp("hugepage",Command[0]) == 0)
+        {
+            iRet = SetHugePageMode(Command[1]);
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Mode must be off, transparent or explicit\n");
+            }
+            else
+            {
+                printf("Huge page mode is set to %s\n",HugePageModeName(Pool.HugePageMode));
+            }
+        }
+
+        // Marvellous CVFS : > benchmark 512
+        else if(strcmp("benchmark",Command[0]) == 0)
+        {
+            iRet = BenchmarkHugePages(atoi(Command[1]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid size or data is kept in image\n");
+            }
+            else if(iRet != EXECUTE_SUCCESS)
+            {
+                printf("Error : Unable to create benchmark file\n");
+            }
+        }
+
+        // Marvellous CVFS : > cache 256
+        else if(strcmp("cache",Command[0]) == 0)
+        {
+            iRet = SetCacheBudget(atoi(Command[1]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid budget or there is no image\n");
+            }
+            else
+            {
+                printf("Page cache budget is set to %s MB\n",Command[1]);
+            }
+        }
+
+        // Marvellous CVFS : > scrub 100
+        else if(strcmp("scrub",Command[0]) == 0)
+        {
+            iRet = SetScrubRate(atoi(Command[1]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid scrub rate\n");
+            }
+            else
+            {
+                printf("Scrub rate is set to %d blocks per second\n",atoi(Command[1]));
+            }
+        }
+
+        // Marvellous CVFS : > defrag off
+        else if(strcmp("defrag",Command[0]) == 0)
+        {
+            if(strcmp("on",Command[1]) == 0 || strcmp("off",Command[1]) == 0)
+            {
+                Pool.DefragEnabled = (strcmp("on",Command[1]) == 0);
+                printf("Background defragmenter is %s\n",Command[1]);
+            }
+            else
+            {
+                printf("Error : Invalid parameter\n");
+            }
+        }
+
+        // Marvellous CVFS : > trace calls.trace
+        else if(strcmp("trace",Command[0]) == 0)
+        {
+            if(strcmp("off",Command[1]) == 0)
+            {
+                lRet = StopTrace();
+
+                if(lRet < 0)
+                {
+                    printf("Error : Trace is not being recorded\n");
+                }
+                else
+                {
+                    printf("%lld calls recorded\n",lRet);
+                }
+            }
+            else
+            {
+                iRet = StartTrace(Command[1]);
+
+                if(iRet == ERR_FILE_ALREADY_EXIST)
+                {
+                    printf("Error : Trace is already being recorded\n");
+                }
+                else if(iRet != EXECUTE_SUCCESS)
+                {
+                    printf("Error : Unable to create trace file\n");
+                }
+                else
+                {
+                    printf("Calls are recorded into %s\n",Command[1]);
+                }
+            }
+        }
+
+        // Marvellous CVFS : > replay calls.trace
+        else if(strcmp("replay",Command[0]) == 0)
+        {
+            lRet = ReplayTrace(Command[1],false);
+
+            if(lRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File system is not empty, start new shell to replay\n");
+            }
+            else if(lRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : Unable to open trace file\n");
+            }
+            else if(lRet < 0)
+            {
+                printf("Error : Invalid trace file or trace is being recorded\n");
+            }
+        }
+
+        // Marvellous CVFS : > events on
+        else if(strcmp("events",Command[0]) == 0)
+        {
+#ifdef CVFS_NO_EVENTS
+            printf("Error : Trace points are removed from this build\n");
+#else
+            if(strcmp("on",Command[1]) == 0)
+            {
+                Events.Enabled = true;
+            }
+            else if(strcmp("off",Command[1]) == 0)
+            {
+                Events.Enabled = false;
+            }
+            else if(strcmp("clear",Command[1]) == 0)
+            {
+                ClearEvents();
+            }
+            else
+            {
+                printf("Error : Use on, off or clear\n");
+                return EXECUTE_SUCCESS;
+            }
 
-    // If the permission value is wrong
-    // permission -> 1 -> READ
-    // permission -> 2 -> WRITE
-    // permission -> 3 -> READ + WRITE
-    if(permission < 1 || permission > 3)
-    {
-        return ERR_INVALID_PARAMETER;
-    }
+            DisplayEvents();
+#endif
+        }
 
-    // If the inodes are full
-    if(superobj.FreeInodes == 0)
-    {
-        return ERR_NO_INODES;
-    }
+        // Marvellous CVFS : > checkpoint /home/user/cvfs.ckpt
+        else if(strcmp("checkpoint",Command[0]) == 0)
+        {
+            DisplayCheckpoint(WriteCheckpoint(Command[1],0));
+        }
 
-    // If file is already present
-    if(IsFileExist(name) == true)
-    {
-        return ERR_FILE_ALREADY_EXIST;
-    }
+        // Marvellous CVFS : > restore /home/user/cvfs.ckpt
+        else if(strcmp("restore",Command[0]) == 0)
+        {
+            lFirst = NanoTime();
+            lRet = RestoreCheckpoint(Command[1],&lLast);
 
-    // Search empty Inode
-    while(temp != NULL)
-    {
-        if(temp -> FileType == 0)
+            if(lRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File system is not empty, start new shell to restore\n");
+            }
+            else if(lRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : Unable to open checkpoint file\n");
+            }
+            else if(lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid checkpoint file\n");
+            }
+            else if(lRet < 0)
+            {
+                printf("Error : Restore stopped as there is no space\n");
+            }
+            else
+            {
+                if(lLast > 0)
+                {
+                    printf("Incomplete tail of %lld bytes is discarded\n",lLast);
+                }
+
+                printf("%lld checkpoints restored in %.3f ms\n",lRet,(NanoTime() - lFirst) / 1e6);
+            }
+        }
+
+        // Marvellous CVFS : > ingest /home/user/photos
+        else if(strcmp("ingest",Command[0]) == 0)
+        {
+            lFirst = NanoTime();
+            lRet = IngestDirectory(Command[1],&Ingest);
+            lLast = NanoTime() - lFirst;
+
+            if(lRet == ERR_FILE_NOT_EXIST || lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Unable to read host directory\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            if(lRet == ERR_NO_INODES)
+            {
+                printf("Error : Ingest stopped as there is no inode\n");
+            }
+            else if(lRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Ingest stopped as quota is used up\n");
+            }
+            else if(lRet < 0)
+            {
+                printf("Error : Ingest stopped as there is no space\n");
+            }
+
+            printf("%lld files (%.1f MB) ingested in %.3f s, %lld skipped\n",Ingest.Ingested,Ingest.Bytes / 1048576.0,lLast / 1e9,Ingest.Skipped);
+            printf("%.0f files/sec, %.1f MB/sec\n",Ingest.Ingested / ((lLast > 0) ? lLast / 1e9 : 1.0),
+                   Ingest.Bytes / 1048576.0 / ((lLast > 0) ? lLast / 1e9 : 1.0));
+        }
+
+        // Marvellous CVFS : > tier off
+        else if(strcmp("tier",Command[0]) == 0)
         {
-            break;    
+            if(strcmp("off",Command[1]) == 0)
+            {
+                Tier.Enabled = false;
+                printf("Tiering is off, spilled files come back on access\n");
+            }
+            else
+            {
+                printf("Error : Invalid parameter\n");
+            }
         }
-        temp = temp -> next;
-    }
-    
-    if(temp == NULL)
-    {
-        printf("There is no inode\n");
-        return ERR_NO_INODES;
-    }
 
-    // Search for empty UFDT entry
-    // Note : 0,1,2 are reserved
-    for(i = 3; i < MAXOPENFILES; i++)
+        else
+        {
+            printf("There is no such command\n");
+        }
+    } // End of else if 2
+    else if(iCount == 3)
     {
-        if(uareaobj.UFDT[i] == NULL)
+        // Marvellous CVFS : > checkpoint /home/user/cvfs.ckpt 50
+        if(strcmp("checkpoint",Command[0]) == 0)
         {
-            break;
+            DisplayCheckpoint(WriteCheckpoint(Command[1],atoi(Command[2])));
         }
-    }
+        // Marvellous CVFS : > events dump /tmp/cvfs.json
+        else if((strcmp("events",Command[0]) == 0) && (strcmp("dump",Command[1]) == 0))
+        {
+            lRet = DumpEvents(Command[2]);
 
-    // UFDT is full
-    if(i == MAXOPENFILES)
-    {
-        return ERR_MAX_FILES_OPEN;
-    }
+            if(lRet < 0)
+            {
+                printf("Error : Unable to write dump file\n");
+            }
+            else
+            {
+                printf("%lld events written to %s\n",lRet,Command[2]);
+            }
+        }
+        // Marvellous CVFS : > flock 3 ex/500
+        else if(strcmp("flock",Command[0]) == 0)
+        {
+            iRet = LockMode(Command[2],&fd);
+
+            DisplayLockError((iRet == -1) ? ERR_INVALID_PARAMETER : LockFile(atoi(Command[1]),0,0,iRet,fd));
+        }
+        // Marvellous CVFS : > ls size 20
+        else if(strcmp("ls",Command[0]) == 0)
+        {
+            if((ListOrder(Command[1]) == -1) || (atoi(Command[2]) <= 0))
+            {
+                printf("Error : Usage is ls name|size|inode count\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            iPageSize = atoi(Command[2]);
+
+            OpenListing(&Listing,ListOrder(Command[1]));
+            LsFile(&Listing,iPageSize);
+        }
+        // Marvellous CVFS : > creat Ganesh.txt 3
+        else if(strcmp("creat",Command[0]) == 0)
+        {
+            if(uareaobj.Transaction != NULL)
+            {
+                iRet = StageCreate(Command[1],atoi(Command[2]));
+
+                if(iRet == ERR_FILE_ALREADY_EXIST)
+                {
+                    printf("Error : File already exists once staged operations are applied\n");
+                }
+                else
+                {
+                    printf("%s\n",(iRet == EXECUTE_SUCCESS) ? "Create is staged" : "Error : Invalid parameter");
+                }
+                return EXECUTE_SUCCESS;
+            }
+
+            iRet = CreateFile(Command[1],atoi(Command[2]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Unable to create the file as parameters are invalid\n");
+                printf("Please refer man page\n");
+            }
+            else if(iRet == ERR_NO_INODES)
+            {
+                printf("Error : Unable to create file as there is no inode\n");
+            }
+            else if(iRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : Unable to create file because the file is already present\n");
+            }
+            else if(iRet == ERR_MAX_FILES_OPEN)
+            {
+                printf("Error : Unable to create file\n");
+                printf("Max opened files limit reached\n");
+            }
+            else if(iRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Unable to create file as inode quota is used up\n");
+            }
+            else if(iRet < 0)
+            {
+                printf("Error : Unable to create file (%d)\n",iRet);
+            }
+            else
+            {
+                printf("File gets succesfully created with FD %d\n",iRet);
+            }
+        } 
+        // Marvellous CVFS : > open Demo.txt 1
+        else if(strcmp("open",Command[0]) == 0)
+        {
+            iRet = OpenFile(Command[1],atoi(Command[2]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet == ERR_MAX_FILES_OPEN)
+            {
+                printf("Error : Max opened files limit reached\n");
+            }
+            else
+            {
+                printf("File gets successfully opened with FD %d\n",iRet);
+            }
+        }
+
+        // Marvellous CVFS : > link Demo.txt Copy.txt
+        // Marvellous CVFS : > rename Demo.txt New.txt
+        else if((strcmp("link",Command[0]) == 0) || (strcmp("rename",Command[0]) == 0))
+        {
+            if(strcmp("link",Command[0]) == 0)
+            {
+                iRet = LinkFile(Command[1],Command[2]);
+            }
+            else
+            {
+                iRet = RenameFile(Command[1],Command[2]);
+            }
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file\n");
+            }
+            else if(iRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File with new name is already present\n");
+            }
+            else
+            {
+                printf("Operation is successful\n");
+            }
+        }
+
+        // Marvellous CVFS : > mwrite 3 100
+        else if(strcmp("mwrite",Command[0]) == 0)
+        {
+            fd = atoi(Command[1]);
+            lRet = atoll(Command[2]);
+
+            if((fd < 0) || (fd >= MAXOPENFILES) || (uareaobj.UFDT[fd] == NULL) || (uareaobj.UFDT[fd]->View == NULL))
+            {
+                printf("Error : There is no such mapped file\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            if((uareaobj.UFDT[fd]->Mode & WRITE) == 0)
+            {
+                printf("Error : View is read only\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            printf("Enter the data that you want to write : \n");
+            fgets(InputBuffer,MAXFILESIZE,stdin);
+
+            iRet = (int)strlen(InputBuffer) - 1;
+
+            if((lRet < 0) || (lRet + iRet > uareaobj.UFDT[fd]->ViewLength))
+            {
+                printf("Error : Data does not fit in view\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            // Plain store into memory, no file system call
+            memcpy(uareaobj.UFDT[fd]->View + lRet,InputBuffer,iRet);
+
+            printf("%d bytes changed in view\n",iRet);
+        }
+
+        // Marvellous CVFS : > replay calls.trace timed
+        else if(strcmp("replay",Command[0]) == 0)
+        {
+            if(strcmp("timed",Command[2]) != 0)
+            {
+                printf("Error : Invalid parameter\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            lRet = ReplayTrace(Command[1],true);
+
+            if(lRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File system is not empty, start new shell to replay\n");
+            }
+            else if(lRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : Unable to open trace file\n");
+            }
+            else if(lRet < 0)
+            {
+                printf("Error : Invalid trace file or trace is being recorded\n");
+            }
+        }
+
+        // Marvellous CVFS : > unlink file_%d 1..100000
+        else if(strcmp("unlink",Command[0]) == 0)
+        {
+            if(uareaobj.Transaction != NULL)
+            {
+                printf("Error : Bulk commands can not be part of batch\n");
+                return EXECUTE_SUCCESS;
+            }
+
+            lFirst = -1;
+            lLast = -1;
+            sscanf(Command[2],"%lld..%lld",&lFirst,&lLast);
+
+            lRet = UnlinkFiles(Command[1],lFirst,lLast);
+
+            if(lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid pattern or range\n");
+                printf("Please refer man page\n");
+            }
+            else
+            {
+                printf("%lld files gets successfully deleted\n",lRet);
+            }
+        }
+
+        // Marvellous CVFS : > cp Demo.txt Copy.txt
+        else if(strcmp("cp",Command[0]) == 0)
+        {
+            iRet = CopyFile(Command[1],Command[2]);
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file\n");
+            }
+            else if(iRet == ERR_FILE_ALREADY_EXIST)
+            {
+                printf("Error : File with new name is already present\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet == ERR_NO_INODES)
+            {
+                printf("Error : There is no inode\n");
+            }
+            else if(iRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Memory or inode quota is used up\n");
+            }
+            else if(iRet != EXECUTE_SUCCESS)
+            {
+                printf("Error : Unable to copy the file\n");
+            }
+            else
+            {
+                printf("File gets successfully copied\n");
+            }
+        }
+
+        // Marvellous CVFS : > truncate Demo.txt 100
+        else if(strcmp("truncate",Command[0]) == 0)
+        {
+            iRet = TruncateFile(Command[1],atoll(Command[2]));
+
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such file\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet == ERR_INSUFFICIENT_SPACE)
+            {
+                printf("Error : Unable to grow the file\n");
+            }
+            else
+            {
+                printf("File size is set to %lld\n",atoll(Command[2]));
+            }
+        }
+
+      // Marvellous CVFS : > read 3 10
+        else if(strcmp("read",Command[0]) == 0)
+        {
+           EmptyBuffer = (char*)calloc(atoll(Command[2]) + 1,1);
+
+           iRet = ReadFile(atoi(Command[1]),EmptyBuffer,atoll(Command[2]));
+
+           if(iRet == ERR_INVALID_PARAMETER)
+           {
+            printf("ERROR: Invalid parameter\n");
+           }
+
+           else if(iRet == ERR_FILE_NOT_EXIST)
+           {
+            printf("ERROR: File not exist\n");
+           }
+
+           else if(iRet == ERR_PERMISSION_DENIED)
+           {
+            printf("ERROR: Permission Denied\n");
+           }
+
+           else if(iRet == ERR_INSUFFICIENT_DATA)
+           {
+            printf("ERROR: Insufficient data\n");
+           }
+
+           else if(iRet == ERR_CHECKSUM_MISMATCH)
+           {
+            printf("ERROR: Data of file is corrupted\n");
+           }
+
+           else if(iRet == ERR_IO)
+           {
+            printf("ERROR: Unable to bring file back from backing file\n");
+           }
+
+           else if(iRet == ERR_WOULD_BLOCK)
+           {
+            printf("ERROR: FIFO is empty\n");
+           }
+
+           else
+           {
+            printf("Read operation is successful\n");
+            printf("Data from file is : %s\n",EmptyBuffer);
+           }
+
+           free(EmptyBuffer);
+        }
+        else
+        {
+            printf("There is no such command");
+        }
+    } // End of else if 3
+    else if(iCount == 4)
+    {
+        // Marvellous CVFS : > creat file_%d 1..100000 3
+        if(strcmp("creat",Command[0]) == 0)
+        {
+            if(uareaobj.Transaction != NULL)
+            {
+                printf("Error : Bulk commands can not be part of batch\n");
+                return EXECUTE_SUCCESS;
+            }
 
-    // Allocate ememory for file table
-    uareaobj.UFDT[i] = (PFILETABLE)malloc(sizeof(FILETABLE));
+            lFirst = -1;
+            lLast = -1;
+            sscanf(Command[2],"%lld..%lld",&lFirst,&lLast);
 
-    // Initialise File table
-    uareaobj.UFDT[i]->ReadOffset = 0;
-    uareaobj.UFDT[i]->WriteOffset = 0;
-    uareaobj.UFDT[i]->Mode = permission;
-    
-    // Connect File table with Inode
-    uareaobj.UFDT[i]->ptrinode = temp;
+            lRet = CreateFiles(Command[1],lFirst,lLast,atoi(Command[3]));
 
-    // Initialise elements of Inode
-    strcpy(uareaobj.UFDT[i]->ptrinode->FileName,name);
-    uareaobj.UFDT[i]->ptrinode->FileSize = MAXFILESIZE;
-    uareaobj.UFDT[i]->ptrinode->ActualFileSize = 0;
-    uareaobj.UFDT[i]->ptrinode->FileType = REGULARFILE;
-    uareaobj.UFDT[i]->ptrinode->ReferenceCount = 1;
-    uareaobj.UFDT[i]->ptrinode->Permission = permission;
+            if(lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid pattern, range or permission\n");
+                printf("Please refer man page\n");
+            }
+            else if(lRet == ERR_NO_INODES)
+            {
+                printf("Error : There are not enough inodes, %d are free\n",superobj.FreeInodes);
+            }
+            else if(lRet == ERR_QUOTA_EXCEEDED)
+            {
+                printf("Error : Unable to create files as inode quota is used up\n");
+            }
+            else
+            {
+                printf("%lld files gets succesfully created\n",lRet);
+            }
+        }
 
-    // Allocate ememory for files data
-    uareaobj.UFDT[i]->ptrinode->Buffer = (char *)malloc(MAXFILESIZE);
+        // Marvellous CVFS : > mmap 3 4096 8192
+        else if(strcmp("mmap",Command[0]) == 0)
+        {
+            iRet = MapFile(atoi(Command[1]),atoll(Command[2]),atoll(Command[3]),&ptrView);
 
-    superobj.FreeInodes--;
+            if(iRet == EXECUTE_SUCCESS)
+            {
+                printf("File gets successfully mapped, %lld bytes\n",uareaobj.UFDT[atoi(Command[1])]->ViewLength);
+            }
+            else if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Offset must be multiple of %d\n",BLOCKSIZE);
+            }
+            else if(iRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such opened file\n");
+            }
+            else if(iRet == ERR_PERMISSION_DENIED)
+            {
+                printf("Error : Permission denied\n");
+            }
+            else if(iRet == ERR_INSUFFICIENT_DATA)
+            {
+                printf("Error : Range is not inside the file\n");
+            }
+            else
+            {
+                printf("Error : Unable to map the file (%d)\n",iRet);
+            }
+        }
 
-    return i;   // File descriptor
-}
+        // Marvellous CVFS : > lseek 3 1048576 0
+        else if(strcmp("lseek",Command[0]) == 0)
+        {
+            lRet = LseekFile(atoi(Command[1]),atoll(Command[2]),atoi(Command[3]));
 
-//////////////////////////////////////////////////////////
-//
-//  Function Name :     LsFile()
-//  Description :       It is used to list all files
-//  Input :             Nothing
-//  Output :            Nothing
-//  Author :            Shravani Kishor Darandale
-//  Date :              16/01/2026
-//
-//////////////////////////////////////////////////////////
+            if(lRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else if(lRet == ERR_FILE_NOT_EXIST)
+            {
+                printf("Error : There is no such opened file\n");
+            }
+            else if(lRet == ERR_INSUFFICIENT_DATA)
+            {
+                printf("Error : Offset is at or after end of file\n");
+            }
+            else
+            {
+                printf("Offset is set to %lld\n",lRet);
+            }
+        }
 
-// ls -l
-void LsFile()
-{
-    PINODE temp = head;
+        // Marvellous CVFS : > quota session 1048576 3
+        else if(strcmp("quota",Command[0]) == 0)
+        {
+            iRet = SetQuota(Command[1],atoll(Command[2]),atoll(Command[3]));
 
-    printf("-----------------------------------------------\n");
-    printf("------ Marvellous CVFS Files Information ------\n");
-    printf("-----------------------------------------------\n");
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter\n");
+            }
+            else
+            {
+                printf("Quota of %s is set\n",Command[1]);
+            }
+        }
+        // Marvellous CVFS : > tier 512 384 30
+        else if(strcmp("tier",Command[0]) == 0)
+        {
+            iRet = SetTierPolicy(atoi(Command[1]),atoi(Command[2]),atoi(Command[3]));
 
-    while(temp != NULL)
+            if(iRet == ERR_INVALID_PARAMETER)
+            {
+                printf("Error : Invalid parameter or image is in use\n");
+            }
+            else if(iRet == ERR_INSUFFICIENT_SPACE)
+            {
+                printf("Error : Unable to create backing file\n");
+            }
+            else
+            {
+                printf("Tiering is on\n");
+            }
+        }
+        else
+        {
+            printf("There is no such command\n");
+        }
+    } // End of else if 4
+    else if(iCount == 5)
     {
-        if(temp -> FileType != 0)
+        // Marvellous CVFS : > lock 3 ex 100 50
+        if(strcmp("lock",Command[0]) == 0)
         {
-            printf("%d\t%s\t%d\n",temp->InodeNumber,temp->FileName,temp->ActualFileSize);
+            iRet = LockMode(Command[2],&fd);
+
+            DisplayLockError((iRet == -1) ? ERR_INVALID_PARAMETER : LockFile(atoi(Command[1]),atoll(Command[3]),atoll(Command[4]),iRet,fd));
         }
-        
-        temp = temp -> next;
-    }
-    
-    printf("-----------------------------------------------\n");
+        else
+        {
+            printf("There is no such command\n");
+        }
+    } // End of else if 5
+    else
+    {
+        printf("Command not found\n");
+        printf("Please refer help option to get more information\n");
+    } // End of else
 
+    return EXECUTE_SUCCESS;
 }
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     UnlinkFile()
-//  Description :       It is used to delete the file
-//  Input :             File Name
-//  Output :            Nothing
+//  Function Name :     JobThread
+//  Description :      It is used to run queued background jobs one
+//                      after other
+//  Input :            Nothing
+//  Output :           Nothing
 //  Author :            Shravani Kishor Darandale
-//  Date :              22/01/2026
+//  Date :              19/10/2026
 //
 //////////////////////////////////////////////////////////
 
-int UnlinkFile(
-                char * name
-              )
+void * JobThread(
+                    void *arg       // Not used
+                )
 {
-    int i = 0;
-
-   if(name == NULL)
-   {
-    return ERR_INVALID_PARAMETER;
-   }
+    PJOB job = NULL;
 
-   if(IsFileExist(name) == false)
-   {
-    return ERR_FILE_NOT_EXIST;
-   }
+    (void)arg;
 
-   //Travel the UFDT
+    pthread_mutex_lock(&Jobs.Lock);
 
-   for(i = 0; i < MAXOPENFILES; i++)
-   {
-     if(uareaobj.UFDT[i] != NULL)
-     {
-        if(strcmp(uareaobj.UFDT[i]->ptrinode->FileName,name) == 0)
+    while(1)
+    {
+        for(job = Jobs.Jobs; (job != NULL) && (job->State != JOB_QUEUED); job = job->next)
         {
-            //Deallocate memory of Buffer
-            free(uareaobj.UFDT[i]->ptrinode->Buffer);
-            uareaobj.UFDT[i]->ptrinode->Buffer = NULL;
+        }
 
-            //Reset all values of INODE
-            //Dont deallocate memory of INODE
+        if(job == NULL)
+        {
+            Jobs.Idle++;
+            pthread_cond_wait(&Jobs.Ready,&Jobs.Lock);
+            Jobs.Idle--;
+            continue;
+        }
 
-            uareaobj.UFDT[i]->ptrinode->FileSize = 0;
-            uareaobj.UFDT[i]->ptrinode->ActualFileSize = 0;
-            uareaobj.UFDT[i]->ptrinode->FileType = 0;
-            uareaobj.UFDT[i]->ptrinode->ReferenceCount = 0;
-            uareaobj.UFDT[i]->ptrinode->Permission = 0;
+        job->State = JOB_RUNNING;
+        job->Start = NanoTime();
 
-            memset(uareaobj.UFDT[i]->ptrinode->FileName,'\0',sizeof(uareaobj.UFDT[i]->ptrinode->FileName));
+        pthread_mutex_unlock(&Jobs.Lock);
 
-            //Deallocate memory of FileTable
-            free(uareaobj.UFDT[i]);
+        CurrentJob = job;
+        ShellCommand(job->Command);
+        CurrentJob = NULL;
 
-            //Set NULL to UFDT
-            uareaobj.UFDT[i] = NULL;
+        fflush(stdout);
 
-            //Increment free INOED's count
+        pthread_mutex_lock(&Jobs.Lock);
 
-            superobj.FreeInodes++;
+        job->State = JOB_DONE;
+        job->End = NanoTime();
+        Jobs.Completed++;
 
-            break; //Imp
-        } //End of if
-     } //End of if
-   } //End of for
-   return EXECUTE_SUCCESS;
+        pthread_cond_broadcast(&Jobs.Finished);
+    }
 
-} //End of Function
+    return NULL;
+}
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     WriteFile()
-//  Description :       It is used to write the data into the file
-//  Input :             File Descriptor
-//                      Address of Buffer which contains data
-//                      Size of data that we want to write
-//  Output :            Number of bytes successfully written
+//  Function Name :     BackgroundMarker
+//  Description :      It is used to find & which ends command line
+//                      and asks for background job. & inside data
+//                      or pattern is part of command.
+//  Input :            Command line
+//  Output :           Index of final & or -1
 //  Author :            Shravani Kishor Darandale
-//  Date :              22/01/2026
+//  Date :              19/10/2026
 //
 //////////////////////////////////////////////////////////
 
-int WriteFile(
-                int fd,
-                char *data,
-                int size
-            )
+int BackgroundMarker(
+                        const char *str     // Command line
+                    )
 {
-  printf("File descriptor: %d\n",fd);
-  printf("Data that we want to write : %s\n",data);
-  printf("Number of bytes that we want to write: %d\n",size);
-
-  //Invalid FD
-  if(fd < 0 || fd > MAXOPENFILES)
-  {
-    return ERR_INVALID_PARAMETER;
-  }
-
-  //FD points to NULL
-  if (uareaobj.UFDT[fd] == NULL)
-  {
-    return ERR_FILE_NOT_EXIST;
-  }
-  
-  //There is no permission to write
-  if(uareaobj.UFDT[fd]->ptrinode->Permission < WRITE)
-  {
-    return ERR_PERMISSION_DENIED;
-  }
-
-  //Insufficient Space
-  if((MAXFILESIZE - uareaobj.UFDT[fd]->WriteOffset) < size)
-  {
-    return ERR_INSUFFICIENT_SPACE;
-  }
-
-  //Write the data into the file
-  strncpy(uareaobj.UFDT[fd]->ptrinode->Buffer + uareaobj.UFDT[fd]->WriteOffset,data,size);
-
-  //Update the writeoffset
-  uareaobj.UFDT[fd]->WriteOffset = uareaobj.UFDT[fd]->WriteOffset + size;
-
+    int iLength = strlen(str);
 
-  //Update the actual file size
-  uareaobj.UFDT[fd]->ptrinode->ActualFileSize = uareaobj.UFDT[fd]->ptrinode->ActualFileSize + size;
+    while((iLength > 0) && (strchr(" \t\r\n",str[iLength - 1]) != NULL))
+    {
+        iLength--;
+    }
 
-  return size;
+    return ((iLength > 0) && (str[iLength - 1] == '&')) ? iLength - 1 : -1;
 }
 
 //////////////////////////////////////////////////////////
 //
-//  Function Name :     ReadFile()
-//  Description :       It is used to read the data into the file
-//  Input :             File Descriptor
-//                      Address of Empty Buffer which contains data
-//                      Size of data that we want to read
-//  Output :            Number of bytes successfully read
+//  Function Name :     SubmitJob
+//  Description :      It is used to queue command line ending with &
+//                      as background job. Thread is added to pool
+//                      when no thread is free, up to one per CPU.
+//  Input :            Command line
+//  Output :           Job id or error code
 //  Author :            Shravani Kishor Darandale
-//  Date :              22/01/2026
+//  Date :              19/10/2026
 //
 //////////////////////////////////////////////////////////
 
-int ReadFile(
-               int fd,
-               char *data,
-               int size
-            )
+int SubmitJob(
+                char *str       // Command line with &
+             )
 {
-    //Invalid fd
-    if(fd < 0 || fd > MAXOPENFILES)
+    PJOB newn = NULL;
+    PJOB *pprev = &Jobs.Jobs;
+    PJOB temp = NULL;
+    pthread_t ThreadId;
+    char Name[80] = {'\0'};
+    int iQueued = 0;
+    int iMax = 0;
+    int iLength = BackgroundMarker(str);
+
+    // Staged operations of batch belong to shell
+    if(uareaobj.Transaction != NULL)
     {
-        return ERR_INVALID_PARAMETER;
+        return ERR_TRANSACTION;
     }
 
-    if(data == NULL)
+    while((iLength > 0) && ((str[iLength - 1] == ' ') || (str[iLength - 1] == '\t')))
     {
-        return ERR_INVALID_PARAMETER;
+        iLength--;
     }
 
-    if(size <= 0)
+    if((iLength == 0) || (sscanf(str,"%79s",Name) != 1))
     {
         return ERR_INVALID_PARAMETER;
     }
 
-    if(uareaobj.UFDT[fd] == NULL)
+    // Commands which read terminal or control shell stay in it
+    if((strcmp(Name,"write") == 0) || (strcmp(Name,"append") == 0) || (strcmp(Name,"mwrite") == 0) ||
+       (strcmp(Name,"exit") == 0) || (strcmp(Name,"clear") == 0) || (strcmp(Name,"jobs") == 0) ||
+       (strcmp(Name,"wait") == 0) || (strcmp(Name,"begin") == 0) || (strcmp(Name,"commit") == 0) ||
+       (strcmp(Name,"abort") == 0))
     {
-        return ERR_FILE_NOT_EXIST;
+        return ERR_PERMISSION_DENIED;
     }
 
-    //Filter for permission
-    if(uareaobj.UFDT[fd]->ptrinode->Permission < READ)
+    newn = (PJOB)calloc(1,sizeof(JOB));
+
+    memcpy(newn->Command,str,iLength);
+    newn->Command[iLength] = '\0';
+    newn->State = JOB_QUEUED;
+
+    iMax = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Second thread lets job run while other one sleeps for a lock
+    if(iMax < 2)
     {
-        return ERR_PERMISSION_DENIED;
+        iMax = 2;
+    }
+    if(iMax > JOBTHREADS)
+    {
+        iMax = JOBTHREADS;
     }
 
-    //Insufficient data
-    if((MAXFILESIZE - uareaobj.UFDT[fd]->ReadOffset) < size)
+    pthread_mutex_lock(&Jobs.Lock);
+
+    newn->Id = Jobs.NextId++;
+
+    for(temp = Jobs.Jobs; temp != NULL; temp = temp->next)
     {
-        return ERR_INSUFFICIENT_DATA;
+        iQueued += (temp->State == JOB_QUEUED);
+        pprev = &temp->next;
     }
 
-    //Read the data
-    strncpy(data,uareaobj.UFDT[fd]->ptrinode->Buffer + uareaobj.UFDT[fd]->ReadOffset,size);
+    *pprev = newn;
+    iQueued++;
 
-    //Update the readoffset
-    uareaobj.UFDT[fd]->ReadOffset = uareaobj.UFDT[fd]->ReadOffset + size;
+    if((iQueued > Jobs.Idle) && (Jobs.Threads < iMax) && (pthread_create(&ThreadId,NULL,JobThread,NULL) == 0))
+    {
+        pthread_detach(ThreadId);
+        Jobs.Threads++;
+    }
 
-    return size;
+    pthread_cond_signal(&Jobs.Ready);
 
+    pthread_mutex_unlock(&Jobs.Lock);
 
+    return newn->Id;
 }
 
 //////////////////////////////////////////////////////////
@@ -729,16 +15842,14 @@ int ReadFile(
 //
 //////////////////////////////////////////////////////////
 
-int main()
+int main(int argc, char *argv[])
 {
-    char str[80] = {'\0'};
-    char Command[5][20] = {{'\0'}};
-    int iCount = 0;
+    char str[MAXCOMMANDLINE] = {'\0'};
     int iRet = 0;
-    char InputBuffer[MAXFILESIZE] = {'\0'};
-    char *EmptyBuffer = NULL;
+    int ch = 0;
 
-    StartAuxillaryDataInitilisation();
+    // Marvellous CVFS image_file cache_MB
+    StartAuxillaryDataInitilisation((argc > 1) ? argv[1] : NULL,(argc > 2) ? atoi(argv[2]) : 0);
 
     printf("-----------------------------------------------\n");
     printf("----- Marvellous CVFS started succesfully -----\n");
@@ -751,193 +15862,56 @@ int main()
 
         strcpy(str,"");
 
+        // Jobs finished since last prompt
+        ReportJobs();
+
         printf("\nMarvellous CVFS : > ");
         fgets(str,sizeof(str),stdin);
-        
-        iCount = sscanf(str,"%s %s %s %s %s",Command[0],Command[1],Command[2],Command[3], Command[4]);
-
-        fflush(stdin);
-
-        if(iCount == 1)
-        {
-            // Marvellous CVFS : > exit
-            if(strcmp("exit",Command[0]) == 0)
-            {
-                printf("Thank you for using Marvellous CVFS\n");
-                printf("Deallocating all the allocated resources\n");
 
-                break;
-            }
-            // Marvellous CVFS : > ls
-            else if(strcmp("ls",Command[0]) == 0)
-            {
-                LsFile();
-            }
-            // Marvellous CVFS : > help
-            else if(strcmp("help",Command[0]) == 0)
-            {
-                DisplayHelp();
-            }
-            // Marvellous CVFS : > clear
-            else if(strcmp("clear",Command[0]) == 0)
-            {
-                #ifdef _WIN32
-                    system("cls");
-                #else
-                    system("clear");
-                #endif
-            }
-        } // End of else if 1
-        else if(iCount == 2)
+        // Longer line is dropped as a whole instead of running as many commands
+        if((strchr(str,'\n') == NULL) && (strlen(str) == sizeof(str) - 1))
         {
-            // Marvellous CVFS : > man ls
-            if(strcmp("man",Command[0]) == 0)
+            do
             {
-                ManPageDisplay(Command[1]);
-            }
+                ch = getchar();
+            } while((ch != '\n') && (ch != EOF));
 
-            // Marvellous CVFS : > unlink Demo.txt
-            if(strcmp("unlink",Command[0]) == 0)
-            {
-               iRet = UnlinkFile(Command[1]);
+            printf("Error : Command line is longer than %d characters\n",(int)sizeof(str) - 2);
+            continue;
+        }
 
-               if (iRet == ERR_INVALID_PARAMETER)
-               {
-                printf("erroe : Invalid paramenter\n");
-               }
+        fflush(stdin);
 
-               if(ERR_FILE_NOT_EXIST)
-               {
-                printf("Unable to delete file\n");
-               }
+        // Marvellous CVFS : > grep Marvellous &
+        if(BackgroundMarker(str) >= 0)
+        {
+            iRet = SubmitJob(str);
 
-               if(iRet == EXECUTE_SUCCESS)
-               {
-                printf("File gets successfully deleted\n");
-               }
-            }
-         
-            //Marvellous CVFS : > write 2
-            else if(strcmp("write",Command[0]) == 0)
+            if(iRet == ERR_TRANSACTION)
             {
-              printf("Enter the data that you want to write : \n");
-              fgets(InputBuffer,MAXFILESIZE,stdin);
-
-              iRet = WriteFile(atoi(Command[1]),InputBuffer,strlen(InputBuffer)-1);
-
-              if(iRet  == ERR_INVALID_PARAMETER)
-              {
-                printf("Error\n");
-              }
-
-              else if(iRet == ERR_FILE_NOT_EXIST)
-              {
-                printf("ERROR : no file\n");
-              }
-               else if(iRet == ERR_PERMISSION_DENIED)
-              {
-                printf("ERROR : unable to write\n");
-              }
-               else if(iRet == ERR_INSUFFICIENT_SPACE)
-              {
-                printf("ERROR : unable to write as there is no space\n");
-              }
-              else
-              {
-                printf("%d bytes successfully written\n",iRet);
-              }
+                printf("Error : Background job can not run while batch is started\n");
             }
-
-
-            else
+            else if(iRet == ERR_PERMISSION_DENIED)
             {
-                printf("There is no such command\n");
+                printf("Error : This command can not run in background\n");
             }
-        } // End of else if 2
-        else if(iCount == 3)
-        {
-            // Marvellous CVFS : > creat Ganesh.txt 3
-            if(strcmp("creat",Command[0]) == 0)
-            {
-                iRet = CreateFile(Command[1],atoi(Command[2]));
-
-                if(iRet == ERR_INVALID_PARAMETER)
-                {
-                    printf("Error : Unable to create the file as parameters are invalid\n");
-                    printf("Please refer man page\n");
-                }
-
-                if(iRet == ERR_NO_INODES)
-                {
-                    printf("Error : Unable to create file as there is no inode\n");
-                }
-
-                if(iRet == ERR_FILE_ALREADY_EXIST)
-                {
-                    printf("Error : Unable to create file because the file is already present\n");
-                }
-
-                if(iRet == ERR_MAX_FILES_OPEN)
-                {
-                    printf("Error : Unable to create file\n");
-                    printf("Max opened files limit reached\n");
-                }
-
-                printf("File gets succesfully created with FD %d\n",iRet);
-            } 
-          // Marvellous CVFS : > read 3 10
-            if(strcmp("read",Command[0]) == 0)
+            else if(iRet < 0)
             {
-               EmptyBuffer = (char*)malloc(sizeof(atoi(Command[2])));
-
-               iRet = ReadFile(atoi(Command[1]),EmptyBuffer,atoi(Command[2]));
-
-               if(iRet = ERR_INVALID_PARAMETER)
-               {
-                printf("ERROR: Invalid parameter\n");
-               }
-
-               else if(iRet = ERR_FILE_NOT_EXIST)
-               {
-                printf("ERROR: File not exist\n");
-               }
-
-               else if(iRet = ERR_PERMISSION_DENIED)
-               {
-                printf("ERROR: Permission Denied\n");
-               }
-
-               else if(iRet = ERR_INSUFFICIENT_DATA)
-               {
-                printf("ERROR: Insufficient data\n");
-               }
-
-               else
-               {
-                printf("Read operation is successful\n");
-                printf("Data from file is : %s\n",EmptyBuffer);
-
-                free(EmptyBuffer);
-               }
-
-               
+                printf("Error : Command is missing before &\n");
             }
             else
             {
-                printf("There is no such command");
+                printf("[%d] Started\n",iRet);
             }
-        } // End of else if 3
-        else if(iCount == 4)
-        {
 
+            continue;
+        }
 
-        } // End of else if 4
-        else
+        if(ShellCommand(str) == SHELL_EXIT)
         {
-            printf("Command not found\n");
-            printf("Please refer help option to get more information\n");
-        } // End of else
+            break;
+        }
     } // End of while
 
     return 0;
-} // End of main
\ No newline at end of file
+} // End of main